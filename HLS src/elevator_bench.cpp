@@ -0,0 +1,335 @@
+// Host-side benchmark for elevator_controller (not part of synthesis).
+// Also checks controller_transition_branchless against controller_transition
+// over every state and input, then times both on predictable and random input.
+// The queued transitions (dispatch_calls, panel_transition,
+// sla_dispatch_calls and dual_rate_transition) are timed on a random call
+// trace.
+// Build on Linux with the Vitis HLS headers on the include path:
+//   g++ -O2 -std=c++14 -I$XILINX_HLS/include elevator_hls.cpp elevator_bench.cpp -o elevator_bench
+
+#include "elevator_hls.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Hardware counters collected around each benchmarked region
+enum counter_id {
+    CNT_CYCLES = 0,
+    CNT_INSTRUCTIONS,
+    CNT_BRANCH_MISSES,
+    CNT_L1D_MISSES,
+    CNT_LLC_MISSES,
+    NUM_COUNTERS
+};
+
+static const char *counter_names[NUM_COUNTERS] = {
+    "cycles", "instructions", "branch-misses", "L1D-misses", "LLC-misses"
+};
+
+// perf_event_open counters in one group: the first counter that opens leads,
+// the rest join it, and the kernel schedules and reads them together, so
+// ratios between them come from the same interval even when multiplexed
+class PerfCounters {
+public:
+    PerfCounters() {
+        open_counter(CNT_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open_counter(CNT_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open_counter(CNT_BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open_counter(CNT_L1D_MISSES, PERF_TYPE_HW_CACHE,
+                     PERF_COUNT_HW_CACHE_L1D |
+                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        open_counter(CNT_LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    }
+
+    ~PerfCounters() {
+        for (int i = 0; i < NUM_COUNTERS; i++) {
+            if (fds[i] >= 0) close(fds[i]);
+        }
+    }
+
+    bool available(int id) const { return fds[id] >= 0; }
+
+    void start() {
+        if (leader < 0) return;
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void stop() {
+        for (int i = 0; i < NUM_COUNTERS; i++) values[i] = 0;
+        if (leader < 0) return;
+        ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // nr, time enabled, time running, then one value per member in open
+        // order; one scale for the group when the PMU multiplexes it
+        uint64_t data[3 + NUM_COUNTERS] = {0};
+        ssize_t bytes = read(leader, data, sizeof(data));
+        if (bytes < (ssize_t)(3 * sizeof(uint64_t)) || data[2] == 0) return;
+        double scale = (double)data[1] / data[2];
+        for (int k = 0; k < members && k < (int)data[0]; k++) {
+            values[member_ids[k]] = (uint64_t)(data[3 + k] * scale);
+        }
+    }
+
+    uint64_t value(int id) const { return values[id]; }
+
+private:
+    int fds[NUM_COUNTERS];
+    uint64_t values[NUM_COUNTERS];
+    int leader = -1;
+    int members = 0;
+    int member_ids[NUM_COUNTERS];  // Counter id of each group member, in open order
+
+    void open_counter(int id, uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = leader < 0 ? 1 : 0;  // Members follow the leader's enable
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        fds[id] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+        values[id] = 0;
+        if (fds[id] < 0) return;
+        if (leader < 0) leader = fds[id];
+        member_ids[members++] = id;
+    }
+};
+
+// Pre-generated controller inputs so input generation is not measured
+struct step_input_t {
+    request_t request;
+    bool reset;
+};
+
+// Sequential requests 1,2,...,15: branches settle into a repeating pattern
+static vector<step_input_t> predictable_inputs(size_t steps) {
+    vector<step_input_t> inputs(steps);
+    for (size_t i = 0; i < steps; i++) {
+        inputs[i].reset = false;
+        inputs[i].request.valid = true;
+        inputs[i].request.floor = (floor_t)(i % 15 + 1);
+    }
+    return inputs;
+}
+
+// Random valid/invalid requests and occasional resets
+static vector<step_input_t> random_inputs(size_t steps, unsigned seed) {
+    mt19937 rng(seed);
+    vector<step_input_t> inputs(steps);
+    for (size_t i = 0; i < steps; i++) {
+        inputs[i].reset = (rng() % 64) == 0;
+        inputs[i].request.valid = (rng() & 1) != 0;
+        inputs[i].request.floor = (floor_t)(rng() % 16);
+    }
+    return inputs;
+}
+
+// Floor bitmaps for the queued transitions: about one new call every eight
+// cycles at a random floor, and occasional resets
+struct call_input_t {
+    unsigned short calls;
+    bool reset;
+};
+
+static vector<call_input_t> random_calls(size_t steps, unsigned seed) {
+    mt19937 rng(seed);
+    vector<call_input_t> inputs(steps);
+    for (size_t i = 0; i < steps; i++) {
+        inputs[i].reset = (rng() % 65536) == 0;
+        inputs[i].calls = (rng() % 8) == 0 ? (unsigned short)(1u << (rng() % 15 + 1)) : 0;
+    }
+    return inputs;
+}
+
+static void report(const char *label, double seconds, size_t count, const PerfCounters &counters,
+                   unsigned long checksum);
+
+// Any queued transition over the call trace; step returns a checksum term
+template <typename State, typename Step>
+static void bench_calls(const char *label, const vector<call_input_t> &inputs, State s, Step step) {
+    unsigned long checksum = 0;
+
+    PerfCounters counters;
+    auto start = chrono::steady_clock::now();
+    counters.start();
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        checksum += step(s, inputs[i]);
+    }
+
+    counters.stop();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report(label, seconds, inputs.size(), counters, checksum);
+}
+
+// Run the scalar controller over an input trace and report per-step counters
+static void bench_scalar_step(const char *label, const vector<step_input_t> &inputs) {
+    floor_t current_floor;
+    state_t current_state;
+    direction_t current_direction;
+    bool request_accepted;
+    unsigned long checksum = 0;
+
+    request_t idle_request;
+    idle_request.valid = false;
+    idle_request.floor = 0;
+    elevator_controller(idle_request, true, current_floor, current_state, current_direction, request_accepted);
+
+    PerfCounters counters;
+    auto start = chrono::steady_clock::now();
+    counters.start();
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        elevator_controller(inputs[i].request, inputs[i].reset,
+                            current_floor, current_state, current_direction, request_accepted);
+        checksum += (unsigned)current_floor + request_accepted;
+    }
+
+    counters.stop();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report(label, seconds, inputs.size(), counters, checksum);
+}
+
+// Pure transition function over the same trace, with or without branches
+template <bool Branchless>
+static void bench_transition(const char *label, const vector<step_input_t> &inputs) {
+    controller_state_t s = CONTROLLER_RESET_STATE;
+    unsigned long checksum = 0;
+
+    PerfCounters counters;
+    auto start = chrono::steady_clock::now();
+    counters.start();
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        unsigned floor = inputs[i].request.floor;
+        bool valid = inputs[i].request.valid;
+        controller_step_t step = Branchless
+            ? controller_transition_branchless(s, floor, valid, inputs[i].reset)
+            : controller_transition(s, floor, valid, inputs[i].reset);
+        s = step.next;
+        checksum += (unsigned)s.floor + step.accepted;
+    }
+
+    counters.stop();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report(label, seconds, inputs.size(), counters, checksum);
+}
+
+static bool same_step(const controller_step_t &a, const controller_step_t &b) {
+    return a.accepted == b.accepted && a.next.floor == b.next.floor && a.next.state == b.next.state &&
+           a.next.direction == b.next.direction && a.next.target == b.next.target &&
+           a.next.has_target == b.next.has_target;
+}
+
+// Compare both transitions over every encodable state and input; returns the mismatch count
+static unsigned long exhaustive_equivalence(unsigned long &cases) {
+    unsigned long mismatches = 0;
+    cases = 0;
+    for (unsigned floor = 0; floor < 16; floor++)
+    for (unsigned state = 0; state < 4; state++)
+    for (int direction = -1; direction <= 1; direction++)
+    for (unsigned target = 0; target < 16; target++)
+    for (int has_target = 0; has_target < 2; has_target++)
+    for (unsigned request_floor = 0; request_floor < 16; request_floor++)
+    for (int inputs = 0; inputs < 4; inputs++) {
+        controller_state_t s = {(unsigned char)floor, (unsigned char)state, (signed char)direction,
+                                (unsigned char)target, has_target != 0};
+        bool valid = inputs & 1, reset = (inputs & 2) != 0;
+        if (!same_step(controller_transition(s, request_floor, valid, reset),
+                       controller_transition_branchless(s, request_floor, valid, reset))) {
+            if (mismatches++ < 5) {
+                cout << "Mismatch: floor " << floor << " state " << state << " direction " << direction
+                     << " target " << target << " has_target " << has_target << " request " << request_floor
+                     << " valid " << valid << " reset " << reset << endl;
+            }
+        }
+        cases++;
+    }
+    return mismatches;
+}
+
+static void report(const char *label, double seconds, size_t count, const PerfCounters &counters,
+                   unsigned long checksum) {
+    double steps = (double)count;
+
+    cout << left << setw(28) << label
+         << right << setw(10) << fixed << setprecision(2) << (seconds * 1e9 / steps) << " ns";
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        if (counters.available(i)) {
+            cout << setw(14) << setprecision(3) << (counters.value(i) / steps);
+        } else {
+            cout << setw(14) << "n/a";
+        }
+    }
+    cout << "   (checksum " << checksum << ")" << endl;
+}
+
+int main(int argc, char **argv) {
+    size_t steps = (argc > 1) ? (size_t)atol(argv[1]) : 10000000;
+
+    cout << "=== Elevator Controller Benchmark (" << steps << " steps, per-step values) ===" << endl;
+    cout << left << setw(28) << "Region" << right << setw(13) << "time";
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        cout << setw(14) << counter_names[i];
+    }
+    cout << endl;
+
+    unsigned long cases;
+    unsigned long mismatches = exhaustive_equivalence(cases);
+    cout << "Branch-free transition: " << cases << " state/input cases, " << mismatches << " mismatches" << endl;
+    if (mismatches) return 1;
+
+    vector<step_input_t> predictable = predictable_inputs(steps);
+    vector<step_input_t> random = random_inputs(steps, 12345);
+    bench_scalar_step("scalar step (predictable)", predictable);
+    bench_scalar_step("scalar step (random)", random);
+    bench_transition<false>("transition (predictable)", predictable);
+    bench_transition<false>("transition (random)", random);
+    bench_transition<true>("branch-free (predictable)", predictable);
+    bench_transition<true>("branch-free (random)", random);
+
+    vector<call_input_t> calls = random_calls(steps, 54321);
+    bench_calls("dispatch_calls", calls, CALL_QUEUE_RESET_STATE, [](call_queue_t &q, const call_input_t &in) {
+        dispatch_step_t step = dispatch_calls(q, in.calls, in.reset, CALL_AGE_LIMIT);
+        q = step.next;
+        return (unsigned)q.car.floor + step.max_wait;
+    });
+    bench_calls("panel_transition", calls, PANEL_RESET_STATE, [](panel_state_t &p, const call_input_t &in) {
+        panel_step_t step = panel_transition(p, in.calls, 0, 0, in.reset, CALL_AGE_LIMIT);
+        p = step.next;
+        return (unsigned)p.queue.car.floor + step.latched;
+    });
+    bench_calls("sla_dispatch_calls", calls, CALL_QUEUE_RESET_STATE, [](call_queue_t &q, const call_input_t &in) {
+        sla_step_t step = sla_dispatch_calls(q, in.calls, in.reset, FLOOR_SLA, CALL_AGE_LIMIT);
+        q = step.dispatch.next;
+        return (unsigned)q.car.floor + (unsigned)step.min_slack;
+    });
+    bench_calls("dual_rate_transition", calls, DUAL_RATE_RESET_STATE,
+                [](dual_rate_state_t &d, const call_input_t &in) {
+        dual_rate_step_t step = dual_rate_transition(d, in.calls, in.reset, CALL_AGE_LIMIT);
+        d = step.next;
+        return (unsigned)d.queue.car.floor + d.scan.max_wait;
+    });
+
+    PerfCounters probe;
+    if (!probe.available(CNT_CYCLES)) {
+        cout << "\nHardware counters unavailable (check /proc/sys/kernel/perf_event_paranoid)" << endl;
+    }
+    return 0;
+}
@@ -16,69 +16,180 @@ void elevator_controller(
     #pragma HLS INTERFACE ap_none port=current_direction
     #pragma HLS INTERFACE ap_none port=request_accepted
 
-    // Static variables to maintain state between calls
-    static floor_t elevator_floor = 1;
-    static state_t elevator_state = STATE_IDLE;
-    static direction_t elevator_direction = DIR_IDLE;
-    static floor_t target_floor = 0;
-    static bool has_target = false;
-
-    // Reset functionality
-    if (reset) {
-        elevator_floor = 1;
-        elevator_state = STATE_IDLE;
-        elevator_direction = DIR_IDLE;
-        target_floor = 0;
-        has_target = false;
-        request_accepted = false;
-    } else {
-        // Process new request only if idle and no current target
-        if (input_request.valid && !has_target && elevator_state == STATE_IDLE) {
-            if (input_request.floor > 0 && input_request.floor <= 15 &&
-                input_request.floor != elevator_floor) {
-                target_floor = input_request.floor;
-                has_target = true;
-                request_accepted = true;
-
-                // Determine direction
-                if (target_floor > elevator_floor) {
-                    elevator_direction = DIR_UP;
-                } else {
-                    elevator_direction = DIR_DOWN;
-                }
-                elevator_state = STATE_MOVING;
-            } else {
-                request_accepted = false;
-            }
-        } else {
-            request_accepted = false;
-        }
-
-        // Move elevator if we have a target
-        if (has_target && elevator_state == STATE_MOVING) {
-            if (elevator_floor < target_floor) {
-                elevator_floor++;
-                elevator_direction = DIR_UP;
-            } else if (elevator_floor > target_floor) {
-                elevator_floor--;
-                elevator_direction = DIR_DOWN;
-            }
-
-            // Check if we've reached the target
-            if (elevator_floor == target_floor) {
-                elevator_state = STATE_DOOR_OPEN;
-                elevator_direction = DIR_IDLE;
-                has_target = false;
-                // In next cycle, will return to IDLE
-            }
-        } else if (elevator_state == STATE_DOOR_OPEN) {
-            // Simple door operation - just return to idle
-            elevator_state = STATE_IDLE;
-        }
-    }
+    // Registered state; the next-state logic is the shared constexpr transition
+    static controller_state_t state = CONTROLLER_RESET_STATE;
+
+    controller_step_t step = controller_transition(state, input_request.floor, input_request.valid, reset);
+    state = step.next;
+    request_accepted = step.accepted;
 
     // Update output ports
-    current_floor = elevator_floor;
-    current_state = elevator_state;
-    current_direction = elevator_direction;
-}
\ No newline at end of file
+    current_floor = state.floor;
+    current_state = state.state;
+    current_direction = state.direction;
+}
+
+void elevator_dispatch_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &oldest_floor
+) {
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+    #pragma HLS INTERFACE ap_none port=input_request
+    #pragma HLS INTERFACE ap_none port=reset
+    #pragma HLS INTERFACE ap_none port=current_floor
+    #pragma HLS INTERFACE ap_none port=current_state
+    #pragma HLS INTERFACE ap_none port=current_direction
+    #pragma HLS INTERFACE ap_none port=request_accepted
+    #pragma HLS INTERFACE ap_none port=pending_calls
+    #pragma HLS INTERFACE ap_none port=max_wait
+    #pragma HLS INTERFACE ap_none port=oldest_floor
+
+    // Age counters are registers, so all floors update in the same cycle
+    static call_queue_t queue = CALL_QUEUE_RESET_STATE;
+    #pragma HLS ARRAY_PARTITION variable=queue.age complete
+
+    dispatch_step_t step = dispatch_transition(queue, input_request.floor, input_request.valid, reset,
+                                               CALL_AGE_LIMIT);
+    queue = step.next;
+    request_accepted = step.accepted;
+
+    current_floor = queue.car.floor;
+    current_state = queue.car.state;
+    current_direction = queue.car.direction;
+    pending_calls = queue.pending;
+    max_wait = step.max_wait;
+    oldest_floor = step.oldest_floor;
+}
+
+void elevator_panel_controller(
+    floor_mask_t hall_up,
+    floor_mask_t hall_down,
+    floor_mask_t car_buttons,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &oldest_floor,
+    ap_uint<5> &calls_latched
+) {
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+    #pragma HLS INTERFACE ap_none port=hall_up
+    #pragma HLS INTERFACE ap_none port=hall_down
+    #pragma HLS INTERFACE ap_none port=car_buttons
+    #pragma HLS INTERFACE ap_none port=reset
+    #pragma HLS INTERFACE ap_none port=current_floor
+    #pragma HLS INTERFACE ap_none port=current_state
+    #pragma HLS INTERFACE ap_none port=current_direction
+    #pragma HLS INTERFACE ap_none port=pending_calls
+    #pragma HLS INTERFACE ap_none port=max_wait
+    #pragma HLS INTERFACE ap_none port=oldest_floor
+    #pragma HLS INTERFACE ap_none port=calls_latched
+
+    // Button levels and pending calls are registers; edge detection and the
+    // merge are a few gates per floor, so all floors ingest in one cycle
+    static panel_state_t panel = PANEL_RESET_STATE;
+    #pragma HLS ARRAY_PARTITION variable=panel.queue.age complete
+
+    panel_step_t step = panel_transition(panel, hall_up, hall_down, car_buttons, reset, CALL_AGE_LIMIT);
+    panel = step.next;
+
+    current_floor = panel.queue.car.floor;
+    current_state = panel.queue.car.state;
+    current_direction = panel.queue.car.direction;
+    pending_calls = panel.queue.pending;
+    max_wait = step.dispatch.max_wait;
+    oldest_floor = step.dispatch.oldest_floor;
+    calls_latched = step.latched;
+}
+
+void elevator_sla_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    slack_t &min_slack,
+    bool &edf_override
+) {
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+    #pragma HLS INTERFACE ap_none port=input_request
+    #pragma HLS INTERFACE ap_none port=reset
+    #pragma HLS INTERFACE ap_none port=current_floor
+    #pragma HLS INTERFACE ap_none port=current_state
+    #pragma HLS INTERFACE ap_none port=current_direction
+    #pragma HLS INTERFACE ap_none port=request_accepted
+    #pragma HLS INTERFACE ap_none port=pending_calls
+    #pragma HLS INTERFACE ap_none port=max_wait
+    #pragma HLS INTERFACE ap_none port=min_slack
+    #pragma HLS INTERFACE ap_none port=edf_override
+
+    // Deadlines are a ROM; slack for every floor is computed in parallel
+    static call_queue_t queue = CALL_QUEUE_RESET_STATE;
+    #pragma HLS ARRAY_PARTITION variable=queue.age complete
+
+    unsigned request = input_request.valid ? 1u << input_request.floor : 0u;
+    sla_step_t step = sla_dispatch_calls(queue, request, reset, FLOOR_SLA, CALL_AGE_LIMIT);
+    queue = step.dispatch.next;
+    request_accepted = step.dispatch.accepted;
+
+    current_floor = queue.car.floor;
+    current_state = queue.car.state;
+    current_direction = queue.car.direction;
+    pending_calls = queue.pending;
+    max_wait = step.dispatch.max_wait;
+    min_slack = step.min_slack;
+    edf_override = step.dispatch.promoted;
+}
+
+void elevator_dual_rate_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &command_floor
+) {
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+    #pragma HLS INTERFACE ap_none port=input_request
+    #pragma HLS INTERFACE ap_none port=reset
+    #pragma HLS INTERFACE ap_none port=current_floor
+    #pragma HLS INTERFACE ap_none port=current_state
+    #pragma HLS INTERFACE ap_none port=current_direction
+    #pragma HLS INTERFACE ap_none port=request_accepted
+    #pragma HLS INTERFACE ap_none port=pending_calls
+    #pragma HLS INTERFACE ap_none port=max_wait
+    #pragma HLS INTERFACE ap_none port=command_floor
+
+    // The scan reads one age per cycle through a mux indexed by the scan
+    // counter, so the dispatch path stays one compare deep; the motion path
+    // only reads the command register and one pending bit
+    static dual_rate_state_t dual = DUAL_RATE_RESET_STATE;
+    #pragma HLS ARRAY_PARTITION variable=dual.queue.age complete
+
+    unsigned request = input_request.valid ? 1u << input_request.floor : 0u;
+    dual_rate_step_t step = dual_rate_transition(dual, request, reset, CALL_AGE_LIMIT);
+    dual = step.next;
+    request_accepted = step.accepted;
+
+    current_floor = dual.queue.car.floor;
+    current_state = dual.queue.car.state;
+    current_direction = dual.queue.car.direction;
+    pending_calls = dual.queue.pending;
+    max_wait = dual.scan.max_wait;
+    command_floor = dual.command.valid ? dual.command.floor : 0;
+}
@@ -8,15 +8,19 @@ typedef ap_uint<4> floor_t;      // 4 bits: floors 0-15
 typedef ap_uint<2> state_t;      // 2 bits: IDLE=0, MOVING=1, DOOR_OPEN=2
 typedef ap_int<2> direction_t;   // 2 bits: DOWN=-1, IDLE=0, UP=1
 
+// Plain-integer encodings, shared by the typed constants and the constexpr transition
+enum { CTRL_IDLE = 0, CTRL_MOVING = 1, CTRL_DOOR_OPEN = 2 };
+enum { CTRL_DOWN = -1, CTRL_STOP = 0, CTRL_UP = 1 };
+
 // States
-const state_t STATE_IDLE = 0;
-const state_t STATE_MOVING = 1;
-const state_t STATE_DOOR_OPEN = 2;
+const state_t STATE_IDLE = CTRL_IDLE;
+const state_t STATE_MOVING = CTRL_MOVING;
+const state_t STATE_DOOR_OPEN = CTRL_DOOR_OPEN;
 
 // Directions
-const direction_t DIR_DOWN = -1;
-const direction_t DIR_IDLE = 0;
-const direction_t DIR_UP = 1;
+const direction_t DIR_DOWN = CTRL_DOWN;
+const direction_t DIR_IDLE = CTRL_STOP;
+const direction_t DIR_UP = CTRL_UP;
 
 // Request structure
 struct request_t {
@@ -24,6 +28,489 @@ struct request_t {
     bool valid;
 };
 
+// Explicit controller state. Fields are plain integers because ap_int types
+// are not literal types, so the transition below can run at compile time.
+struct controller_state_t {
+    unsigned char floor;
+    unsigned char state;
+    signed char direction;
+    unsigned char target;
+    bool has_target;
+};
+
+struct controller_step_t {
+    controller_state_t next;
+    bool accepted;
+};
+
+constexpr controller_state_t CONTROLLER_RESET_STATE = {1, CTRL_IDLE, CTRL_STOP, 0, false};
+
+// One clock cycle of the controller as a pure function. elevator_controller
+// registers the state and drives its ports from it; host tools and
+// static_asserts evaluate the same definition.
+constexpr controller_step_t controller_transition(controller_state_t s, unsigned request_floor,
+                                                  bool request_valid, bool reset) {
+    if (reset) {
+        return controller_step_t{CONTROLLER_RESET_STATE, false};
+    }
+
+    // Process new request only if idle and no current target
+    bool accepted = false;
+    if (request_valid && !s.has_target && s.state == CTRL_IDLE &&
+        request_floor > 0 && request_floor <= 15 && request_floor != s.floor) {
+        s.target = (unsigned char)request_floor;
+        s.has_target = true;
+        s.direction = (s.target > s.floor) ? CTRL_UP : CTRL_DOWN;
+        s.state = CTRL_MOVING;
+        accepted = true;
+    }
+
+    // Move elevator if we have a target
+    if (s.has_target && s.state == CTRL_MOVING) {
+        if (s.floor < s.target) {
+            s.floor++;
+            s.direction = CTRL_UP;
+        } else if (s.floor > s.target) {
+            s.floor--;
+            s.direction = CTRL_DOWN;
+        }
+
+        // Check if we've reached the target; return to IDLE next cycle
+        if (s.floor == s.target) {
+            s.state = CTRL_DOOR_OPEN;
+            s.direction = CTRL_STOP;
+            s.has_target = false;
+        }
+    } else if (s.state == CTRL_DOOR_OPEN) {
+        s.state = CTRL_IDLE;
+    }
+
+    return controller_step_t{s, accepted};
+}
+
+// Select without a branch: a when c, else b
+constexpr int select_int(bool c, int a, int b) {
+    return b ^ ((a ^ b) & -(int)c);
+}
+
+// Same transition as controller_transition, written as straight-line mask
+// arithmetic for software engines where input-dependent branches mispredict.
+// Equivalence over the whole state/input space is checked by elevator_bench.
+constexpr controller_step_t controller_transition_branchless(controller_state_t s, unsigned request_floor,
+                                                             bool request_valid, bool reset) {
+    // Acceptance: (request_floor - 1) < 15 is 0 < request_floor <= 15
+    bool accept = request_valid & !s.has_target & (s.state == CTRL_IDLE) &
+                  ((request_floor - 1u) < 15u) & (request_floor != s.floor);
+    int target = select_int(accept, (int)request_floor, s.target);
+
+    // Movement, arrival and door close, all from the distance to the target
+    bool moving = accept | (s.has_target & (s.state == CTRL_MOVING));
+    int distance = target - s.floor;
+    bool up = moving & (distance > 0);
+    bool down = moving & (distance < 0);
+    bool arrived = moving & ((unsigned)(distance + 1) <= 2u);
+    bool closing = !moving & (s.state == CTRL_DOOR_OPEN);
+
+    int floor = s.floor + (int)up - (int)down;
+    int state = select_int(arrived, CTRL_DOOR_OPEN,
+                           select_int(closing, CTRL_IDLE, select_int(accept, CTRL_MOVING, s.state)));
+    int direction = select_int(arrived, CTRL_STOP, select_int(up, CTRL_UP, select_int(down, CTRL_DOWN, s.direction)));
+    bool has_target = (s.has_target | accept) & !arrived;
+
+    controller_state_t next = {
+        (unsigned char)select_int(reset, CONTROLLER_RESET_STATE.floor, floor),
+        (unsigned char)select_int(reset, CONTROLLER_RESET_STATE.state, state),
+        (signed char)select_int(reset, CONTROLLER_RESET_STATE.direction, direction),
+        (unsigned char)select_int(reset, CONTROLLER_RESET_STATE.target, target),
+        (bool)(has_target & !reset)
+    };
+    return controller_step_t{next, (bool)(accept & !reset)};
+}
+
+// Pending calls in front of the single-target controller. Every floor has a
+// pending bit and a saturating age counter (cycles waited). A call stays
+// pending until a car opens its doors there, so the age is the full hall wait.
+typedef ap_uint<16> call_age_t;
+typedef ap_uint<16> floor_mask_t;  // Bit f: call pending at floor f (bit 0 unused)
+
+const int CALL_FLOORS = 16;
+const unsigned CALL_FLOOR_MASK = 0xFFFE;  // Floors 1-15
+const unsigned CALL_AGE_MAX = 0xFFFF;
+const unsigned CALL_AGE_LIMIT = 64;  // Calls older than this are served oldest-first
+
+struct call_queue_t {
+    controller_state_t car;
+    unsigned short pending;
+    unsigned short age[CALL_FLOORS];
+    signed char sweep;  // Direction of the last dispatch, breaks distance ties
+};
+
+struct dispatch_step_t {
+    call_queue_t next;
+    bool accepted;              // Call(s) latched (or already pending)
+    bool promoted;              // This cycle's dispatch was forced by the age limit
+    unsigned short max_wait;    // Age of the oldest pending call
+    unsigned char oldest_floor; // Its floor, 0 when nothing is pending
+};
+
+constexpr call_queue_t CALL_QUEUE_RESET_STATE = {CONTROLLER_RESET_STATE, 0, {0}, CTRL_UP};
+
+constexpr unsigned popcount16(unsigned x) {
+    unsigned count = 0;
+    for (int b = 0; b < 16; b++) {
+        count += (x >> b) & 1;
+    }
+    return count;
+}
+
+constexpr bool car_free(const call_queue_t &q) {
+    return q.car.state == CTRL_IDLE && !q.car.has_target;
+}
+
+// First half of a dispatch cycle: age pending calls, merge every floor set in
+// new_calls into the pending set at once, and serve calls at the car's floor
+constexpr call_queue_t latch_calls(call_queue_t q, unsigned new_calls) {
+    new_calls &= CALL_FLOOR_MASK;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if ((q.pending >> f) & 1) {
+            q.age[f] = (unsigned short)(q.age[f] < CALL_AGE_MAX ? q.age[f] + 1 : CALL_AGE_MAX);
+        } else if ((new_calls >> f) & 1) {
+            q.age[f] = 0;
+        }
+    }
+    q.pending = (unsigned short)(q.pending | new_calls);
+
+    // A free car, or one with its doors open, serves a call at its floor in place
+    if (car_free(q) || q.car.state == CTRL_DOOR_OPEN) {
+        q.pending = (unsigned short)(q.pending & ~(1u << q.car.floor));
+    }
+    return q;
+}
+
+struct motion_step_t {
+    call_queue_t next;
+    bool accepted;  // The issued call became the car's target
+};
+
+// Car half of a cycle: issue a call (0 for none) if the car is free, step the
+// car, and serve the floor where its doors open
+constexpr motion_step_t move_car(call_queue_t q, unsigned issue) {
+    controller_step_t step = controller_transition(q.car, issue, car_free(q) && issue != 0, false);
+    if (step.accepted) {
+        q.sweep = (signed char)(issue > q.car.floor ? CTRL_UP : CTRL_DOWN);
+    }
+    q.car = step.next;
+
+    // Doors opening at a floor serve its call
+    if (q.car.state == CTRL_DOOR_OPEN) {
+        q.pending = (unsigned short)(q.pending & ~(1u << q.car.floor));
+    }
+    return motion_step_t{q, step.accepted};
+}
+
+// Second half: issue the selected call (0 for none), move the car and report
+// the oldest call
+constexpr dispatch_step_t issue_call(call_queue_t q, unsigned issue, bool accepted, bool promoted) {
+    motion_step_t motion = move_car(q, issue);
+    q = motion.next;
+    unsigned waiting = 0;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (((q.pending >> f) & 1) && (waiting == 0 || q.age[f] > q.age[waiting])) {
+            waiting = f;
+        }
+    }
+
+    return dispatch_step_t{q, accepted, promoted && motion.accepted,
+                           (unsigned short)(waiting ? q.age[waiting] : 0), (unsigned char)waiting};
+}
+
+// One cycle of call latching, ageing and dispatch. While the car is free the
+// nearest pending call is issued to controller_transition, unless the oldest
+// call has waited at least age_limit cycles, in which case it goes first.
+// Nearest-first alone can starve a remote floor indefinitely under steady
+// local traffic; with the promotion rule no call waits much longer than
+// age_limit plus one trip per older call.
+constexpr dispatch_step_t dispatch_calls(call_queue_t q, unsigned new_calls, bool reset, unsigned age_limit) {
+    if (reset) {
+        return dispatch_step_t{CALL_QUEUE_RESET_STATE, false, false, 0, 0};
+    }
+    bool accepted = (new_calls & CALL_FLOOR_MASK) != 0;
+    q = latch_calls(q, new_calls);
+
+    // Oldest and nearest pending calls (ties: lowest floor, then sweep direction)
+    unsigned oldest = 0, nearest = 0;
+    int nearest_distance = CALL_FLOORS;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if ((q.pending >> f) & 1) {
+            if (oldest == 0 || q.age[f] > q.age[oldest]) {
+                oldest = f;
+            }
+            int distance = f > q.car.floor ? f - q.car.floor : q.car.floor - f;
+            bool ahead = (f > q.car.floor) == (q.sweep == CTRL_UP);
+            if (distance < nearest_distance || (distance == nearest_distance && ahead)) {
+                nearest = f;
+                nearest_distance = distance;
+            }
+        }
+    }
+
+    bool promoted = oldest != 0 && q.age[oldest] >= age_limit;
+    return issue_call(q, promoted ? oldest : nearest, accepted, promoted);
+}
+
+// Single-request form, as presented on the request_t port
+constexpr dispatch_step_t dispatch_transition(call_queue_t q, unsigned request_floor, bool request_valid,
+                                              bool reset, unsigned age_limit) {
+    return dispatch_calls(q, request_valid && request_floor < (unsigned)CALL_FLOORS ? 1u << request_floor : 0u,
+                          reset, age_limit);
+}
+
+// Per-floor service deadlines: the longest wait, in cycles, promised to each
+// floor's calls (0: no deadline, at most SLA_DEADLINE_MAX)
+struct sla_table_t {
+    unsigned short deadline[CALL_FLOORS];
+};
+
+const unsigned SLA_DEADLINE_MAX = 4095;
+
+// Slack is signed Q.4 fixed point (1/16 cycle), so travel and stop costs can
+// be fractional when a controller cycle is not one floor of travel
+typedef ap_int<22> slack_t;
+const int SLACK_FRAC_BITS = 4;
+const int ETA_FLOOR_Q = 1 << SLACK_FRAC_BITS;  // Cycles per floor travelled
+const int ETA_STOP_Q = 2 << SLACK_FRAC_BITS;   // Doors open, then re-dispatch, per earlier stop
+const int SLACK_NONE = (int)(SLA_DEADLINE_MAX << SLACK_FRAC_BITS);  // Reported when no deadline is pending
+
+// Example building: premium tenants on floors 13-15, a lobby target, and a
+// looser default elsewhere
+constexpr sla_table_t FLOOR_SLA = {{0, 40, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 24, 24, 24}};
+
+struct sla_choice_t {
+    unsigned floor;  // Call to issue, 0 for none
+    bool edf;        // Chosen by deadline rather than sweep order
+    int min_slack;   // Least slack among pending calls with deadlines, Q.4
+};
+
+// Pending floors strictly between a and b
+constexpr unsigned between_mask(int a, int b) {
+    return a < b ? ((1u << b) - 1) & ~((2u << a) - 1) : ((1u << a) - 1) & ~((2u << b) - 1);
+}
+
+// Next call in sweep order, unless finishing the sweep would miss a deadline.
+// Each pending call's ETA follows the sweep: calls ahead are reached
+// directly, calls behind after the farthest call ahead, and every pending
+// call served on the way adds a stop. Slack is the remaining deadline budget
+// minus that ETA; if any call's slack is negative, the call with the
+// earliest deadline that is still reachable directly in time is served first
+// (EDF). Calls that are already lost do not divert the sweep.
+constexpr sla_choice_t sla_select(const call_queue_t &q, const sla_table_t &sla) {
+    int floor = q.car.floor;
+    unsigned pending = q.pending & CALL_FLOOR_MASK;
+    unsigned above = pending & ~((2u << floor) - 1);
+    unsigned below = pending & ((1u << floor) - 1);
+    bool up = q.sweep == CTRL_UP;
+    if ((up ? above : below) == 0) {
+        up = !up;  // Nothing left ahead: the sweep reverses here
+    }
+    unsigned ahead = up ? above : below;
+    unsigned behind = up ? below : above;
+
+    // Nearest and farthest calls ahead
+    int next = 0, far = floor;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if ((ahead >> f) & 1) {
+            if (next == 0 || (up ? f < next : f > next)) next = f;
+            if (up ? f > far : f < far) far = f;
+        }
+    }
+
+    int min_slack = SLACK_NONE;
+    unsigned edf = 0;
+    int edf_budget = 0;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (!((pending >> f) & 1) || sla.deadline[f] == 0) {
+            continue;
+        }
+        bool is_ahead = (ahead >> f) & 1;
+        int direct = f > floor ? f - floor : floor - f;
+        int path = is_ahead ? direct : (far > floor ? far - floor : floor - far) + (far > f ? far - f : f - far);
+        unsigned earlier = is_ahead ? ahead & between_mask(floor, f)
+                                    : ahead | (behind & between_mask(floor, f));
+        int budget = (int)sla.deadline[f] - (int)q.age[f];
+        int slack = budget * (1 << SLACK_FRAC_BITS) - path * ETA_FLOOR_Q - (int)popcount16(earlier) * ETA_STOP_Q;
+        min_slack = slack < min_slack ? slack : min_slack;
+
+        bool reachable = budget * (1 << SLACK_FRAC_BITS) >= direct * ETA_FLOOR_Q;
+        if (slack < 0 && reachable && (edf == 0 || budget < edf_budget)) {
+            edf = f;
+            edf_budget = budget;
+        }
+    }
+    return sla_choice_t{edf ? edf : (unsigned)next, edf != 0, min_slack};
+}
+
+struct sla_step_t {
+    dispatch_step_t dispatch;  // dispatch.promoted: an EDF or age override was issued
+    int min_slack;
+};
+
+// Dispatch cycle with the sweep/EDF selection in place of nearest-first.
+// EDF overrides can keep turning the sweep away from calls that already
+// missed their deadline, so the age_limit promotion still comes first.
+constexpr sla_step_t sla_dispatch_calls(call_queue_t q, unsigned new_calls, bool reset, const sla_table_t &sla,
+                                        unsigned age_limit) {
+    if (reset) {
+        return sla_step_t{dispatch_step_t{CALL_QUEUE_RESET_STATE, false, false, 0, 0}, SLACK_NONE};
+    }
+    bool accepted = (new_calls & CALL_FLOOR_MASK) != 0;
+    q = latch_calls(q, new_calls);
+    sla_choice_t choice = sla_select(q, sla);
+
+    unsigned oldest = 0;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (((q.pending >> f) & 1) && (oldest == 0 || q.age[f] > q.age[oldest])) {
+            oldest = f;
+        }
+    }
+    bool promoted = oldest != 0 && q.age[oldest] >= age_limit;
+    unsigned issue = promoted ? oldest : choice.floor;
+    return sla_step_t{issue_call(q, issue, accepted, promoted || choice.edf), choice.min_slack};
+}
+
+// Button panels sampled as bitmaps every cycle (bit f: floor f). A call is
+// registered on the rising edge of a button, so a button held through its
+// service does not re-register, and all edges merge into the pending set in
+// the same cycle. Hall up/down and car buttons share one pending bit per
+// floor because the car stops for any of them.
+struct panel_state_t {
+    call_queue_t queue;
+    unsigned short hall_up;    // Button levels sampled last cycle
+    unsigned short hall_down;
+    unsigned short car;
+};
+
+struct panel_step_t {
+    panel_state_t next;
+    dispatch_step_t dispatch;
+    unsigned char latched;     // Floors newly added to the pending set this cycle
+};
+
+constexpr panel_state_t PANEL_RESET_STATE = {CALL_QUEUE_RESET_STATE, 0, 0, 0};
+
+constexpr panel_step_t panel_transition(panel_state_t p, unsigned hall_up, unsigned hall_down, unsigned car,
+                                        bool reset, unsigned age_limit) {
+    // Buttons already held at reset need a fresh press
+    unsigned edges = (hall_up & ~p.hall_up) | (hall_down & ~p.hall_down) | (car & ~p.car);
+    unsigned latched = popcount16(edges & CALL_FLOOR_MASK & ~p.queue.pending);
+    dispatch_step_t step = dispatch_calls(p.queue, edges, reset, age_limit);
+
+    panel_state_t next = {step.next, (unsigned short)hall_up, (unsigned short)hall_down, (unsigned short)car};
+    return panel_step_t{next, step, (unsigned char)(reset ? 0 : latched)};
+}
+
+// Dual-rate controller. The motion path (call latch, controller_transition
+// and door service) runs every cycle; the dispatch decision is made by a
+// scan engine that evaluates one floor per cycle, so a full decision takes
+// DISPATCH_SCAN_CYCLES cycles and its per-cycle logic is a single compare
+// stage however elaborate the policy's per-floor test becomes. The engine
+// writes its choice into a command register; the motion FSM takes it when
+// the car is free and the call is still pending, and drops it otherwise.
+// While the car is busy the engine measures distance from the car's
+// target, so the next command is usually waiting when the car frees up.
+// The policy is dispatch_calls': nearest first, oldest first once a call
+// reaches age_limit.
+const int DISPATCH_SCAN_CYCLES = CALL_FLOORS - 1;
+
+// Command register from the dispatch engine to the motion FSM
+struct motion_command_t {
+    unsigned char floor;
+    bool valid;
+};
+
+// Dispatch engine registers for the pass in progress
+struct dispatch_scan_t {
+    unsigned char floor;             // Floor evaluated this cycle, 1 starts a pass
+    unsigned char from;              // Floor the pass measures distance from
+    signed char sweep;               // Tie-break direction sampled at the start of the pass
+    unsigned char oldest;
+    unsigned char nearest;
+    unsigned char nearest_distance;
+    unsigned short max_wait;         // Oldest call's age at the end of the last pass
+};
+
+struct dual_rate_state_t {
+    call_queue_t queue;
+    motion_command_t command;
+    dispatch_scan_t scan;
+};
+
+struct dual_rate_step_t {
+    dual_rate_state_t next;
+    bool accepted;  // Call(s) latched (or already pending)
+};
+
+constexpr dual_rate_state_t DUAL_RATE_RESET_STATE = {
+    CALL_QUEUE_RESET_STATE, {0, false}, {1, 1, CTRL_UP, 0, 0, CALL_FLOORS, 0}};
+
+// One floor of a dispatch pass. The floor the distance is measured from is
+// skipped: the car's doors serve it on arrival.
+constexpr dispatch_scan_t scan_floor(dispatch_scan_t s, const call_queue_t &q) {
+    if (s.floor == 1) {
+        s.from = q.car.has_target ? q.car.target : q.car.floor;
+        s.sweep = q.sweep;
+        s.oldest = 0;
+        s.nearest = 0;
+        s.nearest_distance = CALL_FLOORS;
+    }
+    int f = s.floor;
+    if (((q.pending >> f) & 1) && f != s.from) {
+        if (s.oldest == 0 || q.age[f] > q.age[s.oldest]) {
+            s.oldest = (unsigned char)f;
+        }
+        int distance = f > s.from ? f - s.from : s.from - f;
+        bool ahead = (f > s.from) == (s.sweep == CTRL_UP);
+        if (distance < s.nearest_distance || (distance == s.nearest_distance && ahead)) {
+            s.nearest = (unsigned char)f;
+            s.nearest_distance = (unsigned char)distance;
+        }
+    }
+    return s;
+}
+
+constexpr dual_rate_step_t dual_rate_transition(dual_rate_state_t d, unsigned new_calls, bool reset,
+                                                unsigned age_limit) {
+    if (reset) {
+        return dual_rate_step_t{DUAL_RATE_RESET_STATE, false};
+    }
+    bool accepted = (new_calls & CALL_FLOOR_MASK) != 0;
+    call_queue_t q = latch_calls(d.queue, new_calls);
+
+    // Motion: a free car takes a command whose call still waits; any other
+    // command is stale once the car is free
+    bool free = car_free(q);
+    unsigned issue = d.command.valid && ((q.pending >> d.command.floor) & 1) ? d.command.floor : 0u;
+    motion_step_t motion = move_car(q, issue);
+    motion_command_t command = d.command;
+    if (free) {
+        command.valid = false;
+    }
+
+    // Dispatch: evaluate this cycle's floor against the latched calls, and at
+    // the end of a pass overwrite the command register with the decision
+    dispatch_scan_t s = scan_floor(d.scan, q);
+    if (s.floor == CALL_FLOORS - 1) {
+        bool promoted = s.oldest != 0 && q.age[s.oldest] >= age_limit;
+        unsigned choice = promoted ? s.oldest : s.nearest;
+        command = motion_command_t{(unsigned char)choice, choice != 0};
+        s.max_wait = s.oldest ? q.age[s.oldest] : 0;
+        s.floor = 1;
+    } else {
+        s.floor++;
+    }
+
+    return dual_rate_step_t{dual_rate_state_t{motion.next, command, s}, accepted};
+}
+
 // Top-level function for HLS
 void elevator_controller(
     request_t input_request,
@@ -34,4 +521,60 @@ void elevator_controller(
     bool &request_accepted
 );
 
+// Queued controller: latches every call, tracks its age and bounds the wait
+void elevator_dispatch_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &oldest_floor
+);
+
+// Bitmap-input controller: every hall and car button sampled each cycle
+void elevator_panel_controller(
+    floor_mask_t hall_up,
+    floor_mask_t hall_down,
+    floor_mask_t car_buttons,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &oldest_floor,
+    ap_uint<5> &calls_latched
+);
+
+// Deadline-aware controller: sweep order with EDF overrides against FLOOR_SLA
+void elevator_sla_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    slack_t &min_slack,
+    bool &edf_override
+);
+
+// Dual-rate controller: motion FSM every cycle, dispatch decided over a
+// DISPATCH_SCAN_CYCLES-cycle scan and passed on through a command register
+void elevator_dual_rate_controller(
+    request_t input_request,
+    bool reset,
+    floor_t &current_floor,
+    state_t &current_state,
+    direction_t &current_direction,
+    bool &request_accepted,
+    floor_mask_t &pending_calls,
+    call_age_t &max_wait,
+    floor_t &command_floor
+);
+
 #endif
\ No newline at end of file
@@ -1,9 +1,171 @@
 #include "elevator_hls.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
+// Compile-time versions of the core scenarios, checked against the same
+// transition function the synthesised controller registers
+constexpr controller_step_t request(controller_state_t s, unsigned floor) {
+    return controller_transition(s, floor, true, false);
+}
+
+constexpr controller_state_t idle_cycles(controller_state_t s, int cycles) {
+    for (int i = 0; i < cycles; i++) {
+        s = controller_transition(s, 0, false, false).next;
+    }
+    return s;
+}
+
+constexpr bool at(controller_state_t s, unsigned floor, unsigned state, int direction) {
+    return s.floor == floor && s.state == state && s.direction == direction;
+}
+
+constexpr controller_state_t AT_FLOOR_3 = idle_cycles(request(CONTROLLER_RESET_STATE, 3).next, 2);
+
+static_assert(at(controller_transition(AT_FLOOR_3, 5, true, true).next, 1, CTRL_IDLE, CTRL_STOP),
+              "reset returns to floor 1 idle");
+static_assert(request(CONTROLLER_RESET_STATE, 3).accepted &&
+              at(request(CONTROLLER_RESET_STATE, 3).next, 2, CTRL_MOVING, CTRL_UP),
+              "request is accepted and movement starts the same cycle");
+static_assert(at(idle_cycles(request(CONTROLLER_RESET_STATE, 3).next, 1), 3, CTRL_DOOR_OPEN, CTRL_STOP),
+              "doors open on arrival");
+static_assert(at(AT_FLOOR_3, 3, CTRL_IDLE, CTRL_STOP), "idle at the target the cycle after the doors open");
+static_assert(request(AT_FLOOR_3, 1).accepted && request(AT_FLOOR_3, 1).next.direction == CTRL_DOWN,
+              "downward request");
+static_assert(!request(CONTROLLER_RESET_STATE, 0).accepted, "floor 0 is rejected");
+static_assert(!request(CONTROLLER_RESET_STATE, 1).accepted, "request for the current floor is rejected");
+static_assert(!request(request(CONTROLLER_RESET_STATE, 5).next, 2).accepted, "requests are ignored while moving");
+
+// Calls alternating between floors 2 and 3, timed so the other local floor
+// is always pending when the car comes free, plus one remote call at 12
+constexpr unsigned local_traffic(int cycle) {
+    return cycle == 1 ? 12 : 2 + ((cycle >> 1) & 1);
+}
+
+// Largest max_wait seen over a run of local traffic
+constexpr unsigned worst_wait(unsigned age_limit, int cycles) {
+    call_queue_t q = CALL_QUEUE_RESET_STATE;
+    unsigned worst = 0;
+    for (int c = 0; c < cycles; c++) {
+        dispatch_step_t step = dispatch_transition(q, local_traffic(c), true, false, age_limit);
+        q = step.next;
+        worst = step.max_wait > worst ? step.max_wait : worst;
+    }
+    return worst;
+}
+
+// Longest trip: the full floor span, then the door cycle before the car is free
+constexpr unsigned MAX_TRIP_CYCLES = (CALL_FLOORS - 2) + 1;
+
+// Wait bound implied by the promotion rule. Once a call reaches age_limit it
+// waits for the trip in progress, one trip per call that is older still
+// (those are promoted first), and its own trip; issue_delay is added to each
+// of those issues (zero when the car takes a call the cycle it frees up).
+constexpr unsigned promoted_wait_bound(unsigned age_limit, unsigned older_calls, unsigned issue_delay) {
+    return age_limit + (older_calls + 2) * MAX_TRIP_CYCLES + (older_calls + 1) * issue_delay;
+}
+
+constexpr dispatch_step_t call(call_queue_t q, unsigned floor) {
+    return dispatch_transition(q, floor, true, false, CALL_AGE_LIMIT);
+}
+
+constexpr dispatch_step_t tick(call_queue_t q) {
+    return dispatch_transition(q, 0, false, false, CALL_AGE_LIMIT);
+}
+
+static_assert(call(CALL_QUEUE_RESET_STATE, 3).accepted &&
+              at(call(CALL_QUEUE_RESET_STATE, 3).next.car, 2, CTRL_MOVING, CTRL_UP),
+              "a call to a free car is dispatched the cycle it arrives");
+static_assert(call(call(CALL_QUEUE_RESET_STATE, 5).next, 2).accepted &&
+              call(call(CALL_QUEUE_RESET_STATE, 5).next, 2).next.pending == ((1 << 5) | (1 << 2)),
+              "calls made while the car is moving are held, not dropped");
+static_assert(tick(call(call(CALL_QUEUE_RESET_STATE, 5).next, 2).next).max_wait == 2 &&
+              tick(call(call(CALL_QUEUE_RESET_STATE, 5).next, 2).next).oldest_floor == 5,
+              "the oldest call's age is reported");
+static_assert(!call(CALL_QUEUE_RESET_STATE, 1).next.pending, "a call at a free car's floor is served in place");
+static_assert(worst_wait(CALL_AGE_MAX, 300) >= 298, "nearest-first alone starves the remote call");
+// Local traffic never ages past the limit, so no call is older than the remote one
+static_assert(worst_wait(CALL_AGE_LIMIT, 300) <= promoted_wait_bound(CALL_AGE_LIMIT, 0, 0),
+              "the age limit bounds the wait");
+
+constexpr unsigned FLOORS_4_7_9 = (1 << 4) | (1 << 7) | (1 << 9);
+
+constexpr panel_step_t press(panel_state_t p, unsigned up, unsigned down, unsigned car) {
+    return panel_transition(p, up, down, car, false, CALL_AGE_LIMIT);
+}
+
+// Hold the same buttons for a number of cycles
+constexpr panel_state_t hold(panel_state_t p, unsigned up, unsigned down, unsigned car, int cycles) {
+    for (int i = 0; i < cycles; i++) {
+        p = press(p, up, down, car).next;
+    }
+    return p;
+}
+
+static_assert(press(PANEL_RESET_STATE, 1 << 4, 1 << 7, 1 << 9).latched == 3 &&
+              (press(PANEL_RESET_STATE, 1 << 4, 1 << 7, 1 << 9).next.queue.pending & FLOORS_4_7_9) == FLOORS_4_7_9,
+              "presses on several floors all latch in one cycle");
+static_assert(press(PANEL_RESET_STATE, 1 << 4, 1 << 4, 1 << 4).latched == 1,
+              "hall and car calls for one floor merge");
+static_assert(!hold(PANEL_RESET_STATE, 0, 0, 1 << 3, 4).queue.pending &&
+              press(hold(PANEL_RESET_STATE, 0, 0, 1 << 3, 4), 0, 0, 1 << 3).latched == 0,
+              "a button held through its service does not re-register");
+static_assert(press(press(hold(PANEL_RESET_STATE, 0, 0, 1 << 3, 4), 0, 0, 0).next, 0, 0, 1 << 3).latched == 1,
+              "releasing and pressing again registers a new call");
+static_assert(press(PANEL_RESET_STATE, 1, 0, 0).latched == 0, "bit 0 is not a floor");
+
+// Car idle at floor 5 after sweeping up, calls pending at floors 3 and 8
+constexpr call_queue_t sweep_queue(unsigned short age3, unsigned short age8) {
+    return call_queue_t{{5, CTRL_IDLE, CTRL_STOP, 0, false}, (1 << 3) | (1 << 8),
+                        {0, 0, 0, age3, 0, 0, 0, 0, age8, 0, 0, 0, 0, 0, 0, 0}, CTRL_UP};
+}
+
+constexpr sla_table_t FLOOR_3_SLA = {{0, 0, 0, 12}};
+constexpr sla_table_t NO_DEADLINES = {{0}};
+
+static_assert(sla_select(sweep_queue(0, 0), NO_DEADLINES).floor == 8 &&
+              !sla_select(sweep_queue(0, 0), NO_DEADLINES).edf,
+              "without deadline pressure the sweep continues upward");
+// Sweep ETA to floor 3: up 3 floors, back 5, one stop at 8 = 8 * 16 + 32 in Q.4
+static_assert(sla_select(sweep_queue(0, 0), FLOOR_3_SLA).min_slack == 12 * 16 - 8 * 16 - 32,
+              "slack is the deadline budget minus the sweep ETA, in Q.4");
+static_assert(sla_select(sweep_queue(0, 0), FLOOR_3_SLA).floor == 8, "positive slack keeps sweep order");
+static_assert(sla_select(sweep_queue(4, 0), FLOOR_3_SLA).floor == 3 && sla_select(sweep_queue(4, 0), FLOOR_3_SLA).edf,
+              "a deadline at risk overrides the sweep");
+static_assert(sla_select(sweep_queue(11, 0), FLOOR_3_SLA).floor == 8,
+              "a deadline that can no longer be met does not divert the sweep");
+static_assert(sla_select(CALL_QUEUE_RESET_STATE, FLOOR_SLA).floor == 0 &&
+              sla_select(CALL_QUEUE_RESET_STATE, FLOOR_SLA).min_slack == SLACK_NONE, "nothing pending");
+
+// Dual-rate controller: cycles from a call at `first` (pressed at reset)
+// until the car starts moving, and from the car freeing up there until it
+// moves on to `second` (pressed 3 cycles in)
+constexpr int first_move(unsigned first) {
+    dual_rate_state_t d = DUAL_RATE_RESET_STATE;
+    for (int c = 0; c < 80; c++) {
+        d = dual_rate_transition(d, c == 0 ? 1u << first : 0u, false, CALL_AGE_LIMIT).next;
+        if (d.queue.car.state == CTRL_MOVING) return c;
+    }
+    return -1;
+}
+
+constexpr int handover(unsigned first, unsigned second) {
+    dual_rate_state_t d = DUAL_RATE_RESET_STATE;
+    int freed = -1;
+    for (int c = 0; c < 120; c++) {
+        if (freed < 0 && car_free(d.queue) && d.queue.car.floor == first) freed = c;
+        d = dual_rate_transition(d, c == 0 ? 1u << first : c == 3 ? 1u << second : 0u, false, CALL_AGE_LIMIT).next;
+        if (freed >= 0 && d.queue.car.state == CTRL_MOVING) return c - freed;
+    }
+    return -1;
+}
+
+static_assert(first_move(5) == DISPATCH_SCAN_CYCLES, "a call to an idle car is issued when the first pass ends");
+static_assert(handover(15, 3) == 0, "after a long trip the next command is waiting when the car frees up");
+static_assert(handover(5, 9) <= DISPATCH_SCAN_CYCLES, "after a short trip it follows within one pass");
+
 int main() {
     cout << "=== Minimal HLS Elevator Controller Test ===" << endl;
 
@@ -120,6 +282,128 @@ int main() {
     }
     test_count++;
 
+    // Test 6: Queued controller holds calls and bounds their wait
+    cout << "\n--- Test 6: Pending-call ages and anti-starvation ---" << endl;
+    floor_mask_t pending_calls;
+    call_age_t max_wait;
+    floor_t oldest_floor;
+    unsigned worst = 0;
+    bool remote_served = false;
+
+    elevator_dispatch_controller(input_request, true, current_floor, current_state, current_direction,
+                                 request_accepted, pending_calls, max_wait, oldest_floor);
+    input_request.valid = true;
+    for (int cycle = 0; cycle < 300; cycle++) {
+        input_request.floor = local_traffic(cycle);
+        elevator_dispatch_controller(input_request, false, current_floor, current_state, current_direction,
+                                     request_accepted, pending_calls, max_wait, oldest_floor);
+        worst = max(worst, (unsigned)max_wait);
+        remote_served |= current_floor == 12 && current_state == STATE_DOOR_OPEN;
+    }
+    cout << "Worst wait under local traffic: " << worst << " cycles (limit " << CALL_AGE_LIMIT
+         << "), remote call served: " << remote_served << endl;
+
+    if (remote_served && worst <= promoted_wait_bound(CALL_AGE_LIMIT, 0, 0)) {
+        cout << "Anti-starvation test PASSED" << endl;
+        pass_count++;
+    } else {
+        cout << "Anti-starvation test FAILED" << endl;
+    }
+    test_count++;
+
+    // Test 7: Whole button panels ingested per cycle
+    cout << "\n--- Test 7: Button-panel bitmaps ---" << endl;
+    ap_uint<5> calls_latched;
+    floor_mask_t all_floors = CALL_FLOOR_MASK;
+    unsigned served = 0, latched_first = 0;
+
+    elevator_panel_controller(0, 0, 0, true, current_floor, current_state, current_direction,
+                              pending_calls, max_wait, oldest_floor, calls_latched);
+    // Every hall button pressed in one cycle and held; car buttons tapped once
+    for (int cycle = 0; cycle < 200 && (cycle == 0 || pending_calls != 0); cycle++) {
+        floor_mask_t car_buttons = cycle == 0 ? all_floors : floor_mask_t(0);
+        elevator_panel_controller(all_floors, all_floors, car_buttons, false, current_floor, current_state,
+                                  current_direction, pending_calls, max_wait, oldest_floor, calls_latched);
+        if (cycle == 0) latched_first = calls_latched;
+        served += current_state == STATE_DOOR_OPEN;
+    }
+    cout << "Calls latched in the first cycle: " << latched_first << ", stops made: " << served
+         << ", still pending: " << pending_calls << endl;
+
+    // Floor 1 is served in place; the other 14 floors each get one stop
+    if (latched_first == 15 && served == 14 && pending_calls == 0) {
+        cout << "Panel ingestion test PASSED" << endl;
+        pass_count++;
+    } else {
+        cout << "Panel ingestion test FAILED" << endl;
+    }
+    test_count++;
+
+    // Test 8: Deadline-aware controller serves a premium floor ahead of the sweep
+    cout << "\n--- Test 8: Per-floor deadlines (EDF) ---" << endl;
+    slack_t min_slack;
+    bool edf_override;
+    bool any_override = false;
+    int served_cycle = -1;
+    const int press_cycle = 13;
+
+    elevator_sla_controller(input_request, true, current_floor, current_state, current_direction,
+                            request_accepted, pending_calls, max_wait, min_slack, edf_override);
+    // Car goes up to 12 and turns down for calls at 2-6; floor 14 (deadline 24)
+    // calls behind it, and finishing the downward sweep first would take too long
+    for (int cycle = 0; cycle < 80 && served_cycle < 0; cycle++) {
+        unsigned floor = cycle == 0 ? 12 : cycle <= 5 ? 1 + cycle : cycle == press_cycle ? 14 : 0;
+        input_request.valid = floor != 0;
+        input_request.floor = floor;
+        elevator_sla_controller(input_request, false, current_floor, current_state, current_direction,
+                                request_accepted, pending_calls, max_wait, min_slack, edf_override);
+        any_override |= edf_override;
+        if (cycle > press_cycle && current_floor == 14 && current_state == STATE_DOOR_OPEN) served_cycle = cycle;
+    }
+    cout << "Floor 14 waited " << served_cycle - press_cycle << " cycles (deadline " << FLOOR_SLA.deadline[14]
+         << "), EDF override: " << any_override << endl;
+
+    if (any_override && served_cycle > 0 && served_cycle - press_cycle <= FLOOR_SLA.deadline[14]) {
+        cout << "Deadline test PASSED" << endl;
+        pass_count++;
+    } else {
+        cout << "Deadline test FAILED" << endl;
+    }
+    test_count++;
+
+    // Test 9: Dual-rate controller serves everything with a multi-cycle dispatch
+    cout << "\n--- Test 9: Dual-rate motion and dispatch ---" << endl;
+    floor_t command_floor;
+    worst = 0;
+    remote_served = false;
+    int drained = -1;
+
+    elevator_dual_rate_controller(input_request, true, current_floor, current_state, current_direction,
+                                  request_accepted, pending_calls, max_wait, command_floor);
+    for (int cycle = 0; cycle < 500 && drained < 0; cycle++) {
+        input_request.valid = cycle < 300;
+        input_request.floor = local_traffic(cycle);
+        elevator_dual_rate_controller(input_request, false, current_floor, current_state, current_direction,
+                                      request_accepted, pending_calls, max_wait, command_floor);
+        worst = max(worst, (unsigned)max_wait);
+        remote_served |= current_floor == 12 && current_state == STATE_DOOR_OPEN;
+        if (cycle >= 300 && pending_calls == 0) drained = cycle;
+    }
+    cout << "Worst wait: " << worst << " cycles, remote call served: " << remote_served
+         << ", queue empty " << drained - 300 << " cycles after the traffic stopped" << endl;
+
+    // Promotion is decided at the end of a scan pass, so each issue can lag
+    // by up to DISPATCH_SCAN_CYCLES. A command written before the remote call
+    // reached the limit may also still be taken when the car frees up: one
+    // extra trip, counted as an older call.
+    if (remote_served && drained >= 0 && worst <= promoted_wait_bound(CALL_AGE_LIMIT, 1, DISPATCH_SCAN_CYCLES)) {
+        cout << "Dual-rate test PASSED" << endl;
+        pass_count++;
+    } else {
+        cout << "Dual-rate test FAILED" << endl;
+    }
+    test_count++;
+
     // Final results
     cout << "\n=== Test Results ===" << endl;
     cout << "Passed: " << pass_count << "/" << test_count << endl;
@@ -0,0 +1,384 @@
+// Memoised dispatch decisions for an expensive exact policy
+// (host-side tool, not part of synthesis).
+//
+// The exact policy picks, whenever the car is free, the pending call that
+// starts the order of stops with the least total completion time over all
+// pending calls. Travel and stop costs are ETA_FLOOR_Q and ETA_STOP_Q, as
+// in sla_select. The order is found by Held-Karp dynamic programming over
+// subsets of the pending floors, O(2^k k^2) for k pending calls. Measured
+// here, a decision averages a few microseconds at 0.4 calls per cycle and
+// a few tens of nanoseconds at 0.1.
+//
+// That decision depends only on the car's floor, its sweep direction (the
+// tie-break) and the pending set. Those pack into a 20-bit key, so
+// decisions are memoised in a bounded open-addressing table: power-of-two
+// slots, multiplicative hashing, linear probing over at most MEMO_MAX_PROBE
+// slots, and a rotating victim within that window once it is full. The
+// key and decision arrays are fixed-size (5 bytes per slot) and need no
+// allocation per lookup. Age promotion (CALL_AGE_LIMIT) is checked before
+// the cache, as in sla_dispatch_calls, because ages are not part of the key.
+//
+// Not done: use in a live runtime. The cache is only exercised by this
+// tool; no synthesised controller or Python dispatcher in the tree calls it.
+//
+// Random hall calls are run through latch_calls/issue_call with nearest
+// first, the uncached exact policy, and the exact policy behind tables of
+// several sizes. Every cached run must serve calls exactly as the uncached
+// one does, so all of them face the same sequence of decisions. A single
+// decision can be far shorter than a clock read, so decisions are not timed
+// one by one: the uncached run records the queue at every decision, and
+// each policy then decides that whole sequence in a timed batch, with a
+// fresh table per batch. After a warm-up, every repeat times each policy in
+// rotating order and medians are reported. The report gives waits, hit
+// rates and the cost per decision, and states whether the default-size
+// table made decisions cheaper by more than the spread of the uncached
+// batches. Repeated decisions are mostly the cheap ones with few pending
+// calls, so at heavy load the saving is well below the hit rate; at light
+// load it is a large share of a decision that was already cheap.
+//
+// Build: g++ -O2 -std=c++14 -I$XILINX_HLS/include elevator_hls.cpp elevator_memo.cpp -o elevator_memo
+// Usage: elevator_memo [calls_per_cycle=0.4] [cycles=500000] [lobby_share=0.25] [slots=131072] [repeats=5]
+
+#include "elevator_hls.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+static const unsigned MEMO_MAX_PROBE = 8;
+
+// Floor (4 bits), pending floors 1-15 (15 bits) and sweep (1 bit)
+static inline uint32_t dispatch_key(const call_queue_t &q) {
+    return (uint32_t)((q.pending & CALL_FLOOR_MASK) >> 1) | (uint32_t)q.car.floor << 15 |
+           (uint32_t)(q.sweep == CTRL_UP) << 19;
+}
+
+struct memo_counters_t {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+};
+
+class DecisionCache {
+public:
+    explicit DecisionCache(unsigned slots) {
+        unsigned log2 = 3;
+        while ((1u << log2) < slots) log2++;
+        shift_ = 32 - log2;
+        keys_.assign(1u << log2, 0);
+        decisions_.assign(1u << log2, 0);
+    }
+
+    bool lookup(uint32_t key, unsigned &decision) {
+        counters.lookups++;
+        const uint32_t mask = (uint32_t)keys_.size() - 1;
+        for (uint32_t i = 0, slot = home(key); i < MEMO_MAX_PROBE; i++, slot = (slot + 1) & mask) {
+            if (keys_[slot] == key + 1) {
+                decision = decisions_[slot];
+                counters.hits++;
+                return true;
+            }
+            if (keys_[slot] == 0) break;
+        }
+        return false;
+    }
+
+    void insert(uint32_t key, unsigned decision) {
+        counters.inserts++;
+        const uint32_t mask = (uint32_t)keys_.size() - 1;
+        uint32_t slot = home(key);
+        for (uint32_t i = 0; i < MEMO_MAX_PROBE; i++, slot = (slot + 1) & mask) {
+            if (keys_[slot] == 0 || keys_[slot] == key + 1) {
+                store(slot, key, decision);
+                return;
+            }
+        }
+        // Probe window full: replace one of its slots in turn
+        counters.evictions++;
+        store((home(key) + victim_++ % MEMO_MAX_PROBE) & mask, key, decision);
+    }
+
+    size_t slots() const { return keys_.size(); }
+
+    size_t occupied() const { return keys_.size() - count(keys_.begin(), keys_.end(), 0u); }
+
+    memo_counters_t counters;
+
+private:
+    uint32_t home(uint32_t key) const { return (key * 0x9E3779B1u) >> shift_; }
+
+    void store(uint32_t slot, uint32_t key, unsigned decision) {
+        keys_[slot] = key + 1;  // 0 marks an empty slot
+        decisions_[slot] = (uint8_t)decision;
+    }
+
+    vector<uint32_t> keys_;
+    vector<uint8_t> decisions_;
+    unsigned shift_;
+    unsigned victim_ = 0;
+};
+
+// First call of the stop order with the least total completion time. Each
+// leg's cost counts once per call still waiting at its start; ties go to
+// the lower floor ahead in the sweep, then the lower floor.
+static unsigned exact_next_call(const call_queue_t &q) {
+    unsigned floors[CALL_FLOORS];
+    int k = 0;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (((q.pending >> f) & 1) && f != q.car.floor) floors[k++] = f;
+    }
+    if (k <= 1) return k ? floors[0] : 0;
+
+    static vector<uint32_t> cost;
+    static vector<uint8_t> first;
+    const uint32_t full = (1u << k) - 1;
+    cost.assign((size_t)(full + 1) * k, UINT32_MAX);
+    first.resize((size_t)(full + 1) * k);
+
+    auto travel = [](int a, int b) { return (uint32_t)(a > b ? a - b : b - a) * ETA_FLOOR_Q; };
+    for (int j = 0; j < k; j++) {
+        cost[(1u << j) * k + j] = travel(q.car.floor, floors[j]) * k;
+        first[(1u << j) * k + j] = (uint8_t)j;
+    }
+    for (uint32_t mask = 1; mask <= full; mask++) {
+        int waiting = k - __builtin_popcount(mask);
+        if (waiting == 0) continue;
+        for (int j = 0; j < k; j++) {
+            uint32_t c = cost[mask * k + j];
+            if (c == UINT32_MAX) continue;
+            for (int l = 0; l < k; l++) {
+                if ((mask >> l) & 1) continue;
+                uint32_t next = c + (ETA_STOP_Q + travel(floors[j], floors[l])) * waiting;
+                uint32_t &slot = cost[(mask | 1u << l) * k + l];
+                if (next < slot) {
+                    slot = next;
+                    first[(mask | 1u << l) * k + l] = first[mask * k + j];
+                }
+            }
+        }
+    }
+
+    unsigned best = 0;
+    uint32_t best_cost = UINT32_MAX;
+    for (int j = 0; j < k; j++) {
+        uint32_t c = cost[full * k + j];
+        unsigned f = floors[first[full * k + j]];
+        bool ahead = (f > q.car.floor) == (q.sweep == CTRL_UP);
+        bool best_ahead = (best > q.car.floor) == (q.sweep == CTRL_UP);
+        if (c < best_cost || (c == best_cost && ((ahead && !best_ahead) || (ahead == best_ahead && f < best)))) {
+            best = f;
+            best_cost = c;
+        }
+    }
+    return best;
+}
+
+enum policy_id { POLICY_NEAREST = 0, POLICY_EXACT, POLICY_MEMO };
+
+struct run_result_t {
+    vector<unsigned> waits;
+    uint64_t decisions = 0;    // Times the car was free with calls pending
+    uint64_t evaluations = 0;  // Exact-policy evaluations actually run
+    double seconds = 0;
+    memo_counters_t counters;
+    size_t occupied = 0;
+    vector<call_queue_t> decision_queues;  // Queue at every decision, uncached exact runs only
+};
+
+static inline uint32_t xorshift(uint32_t &x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+static run_result_t run_policy(int policy, double rate, uint64_t cycles, double lobby_share, unsigned slots) {
+    run_result_t result;
+    DecisionCache cache(slots);
+    uint32_t x = 0x2545f491u;  // Same call sequence for every policy
+    const uint32_t threshold = (uint32_t)(rate * 4294967295.0);
+    const uint32_t lobby_threshold = (uint32_t)(lobby_share * 4294967295.0);
+
+    auto start = chrono::steady_clock::now();
+    call_queue_t q = CALL_QUEUE_RESET_STATE;
+    for (uint64_t c = 0; c < cycles; c++) {
+        unsigned new_calls = 0;
+        if (xorshift(x) < threshold) {
+            unsigned floor = xorshift(x) < lobby_threshold ? 1 : 2 + xorshift(x) % (CALL_FLOORS - 2);
+            new_calls = 1u << floor;
+        }
+
+        dispatch_step_t step{};
+        if (policy == POLICY_NEAREST) {
+            step = dispatch_calls(q, new_calls, false, CALL_AGE_LIMIT);
+        } else {
+            call_queue_t latched = latch_calls(q, new_calls);
+            unsigned oldest = 0;
+            for (int f = 1; f < CALL_FLOORS; f++) {
+                if (((latched.pending >> f) & 1) && (oldest == 0 || latched.age[f] > latched.age[oldest])) {
+                    oldest = f;
+                }
+            }
+            bool promoted = oldest != 0 && latched.age[oldest] >= CALL_AGE_LIMIT;
+            unsigned issue = promoted ? oldest : 0;
+            if (!promoted && car_free(latched) && (latched.pending & CALL_FLOOR_MASK)) {
+                result.decisions++;
+                if (policy == POLICY_EXACT) result.decision_queues.push_back(latched);
+                uint32_t key = dispatch_key(latched);
+                if (policy == POLICY_EXACT || !cache.lookup(key, issue)) {
+                    issue = exact_next_call(latched);
+                    result.evaluations++;
+                    if (policy == POLICY_MEMO) cache.insert(key, issue);
+                }
+            }
+            step = issue_call(latched, issue, new_calls != 0, promoted);
+        }
+
+        unsigned served = (q.pending | new_calls) & ~step.next.pending & CALL_FLOOR_MASK;
+        for (int f = 1; f < CALL_FLOORS; f++) {
+            if ((served >> f) & 1) result.waits.push_back(((q.pending >> f) & 1) ? q.age[f] + 1u : 0u);
+        }
+        q = step.next;
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.counters = cache.counters;
+    result.occupied = cache.occupied();
+    return result;
+}
+
+// Decide a recorded sequence as the policy would in the run, cache included;
+// returns the batch's seconds
+static double time_decisions(const vector<call_queue_t> &queues, int policy, unsigned slots, uint64_t &sink) {
+    DecisionCache cache(slots);
+    auto start = chrono::steady_clock::now();
+    for (const call_queue_t &q : queues) {
+        unsigned issue;
+        uint32_t key = dispatch_key(q);
+        if (policy == POLICY_EXACT || !cache.lookup(key, issue)) {
+            issue = exact_next_call(q);
+            if (policy == POLICY_MEMO) cache.insert(key, issue);
+        }
+        sink += issue;
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static double median(vector<double> v) {
+    sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+int main(int argc, char **argv) {
+    double rate = argc > 1 ? atof(argv[1]) : 0.4;
+    uint64_t cycles = argc > 2 ? strtoull(argv[2], nullptr, 10) : 500000;
+    double lobby_share = argc > 3 ? atof(argv[3]) : 0.25;
+    unsigned slots = argc > 4 ? (unsigned)atoi(argv[4]) : 131072;  // 640 KB; under half full at the defaults
+    int repeats = argc > 5 ? atoi(argv[5]) : 5;
+    if (rate <= 0 || rate > 1 || cycles == 0 || slots == 0 || repeats < 1) {
+        cerr << "calls_per_cycle must be in (0, 1], cycles, slots and repeats positive" << endl;
+        return 1;
+    }
+
+    cout << "=== Memoised Exact Dispatch ===" << endl;
+    cout << "Calls per cycle: " << rate << ", cycles: " << cycles << ", lobby share: " << lobby_share
+         << ", key space: " << (1u << 20) << ", median of " << repeats << endl;
+
+    struct row_t {
+        string name;
+        run_result_t result;
+        unsigned slots;
+        vector<double> batch_seconds;  // Timed decision batches, one per repeat
+    };
+    vector<row_t> rows;
+    rows.push_back({"nearest", run_policy(POLICY_NEAREST, rate, cycles, lobby_share, 8), 0, {}});
+    rows.push_back({"exact", run_policy(POLICY_EXACT, rate, cycles, lobby_share, 8), 0, {}});
+    vector<unsigned> sizes = {4096, 32768, slots, 4 * slots};
+    sort(sizes.begin(), sizes.end());
+    sizes.erase(unique(sizes.begin(), sizes.end()), sizes.end());
+    size_t default_row = 0;
+    for (unsigned s : sizes) {
+        if (s == slots) default_row = rows.size();
+        run_result_t r = run_policy(POLICY_MEMO, rate, cycles, lobby_share, s);
+        rows.push_back({"exact+memo", r, (unsigned)DecisionCache(s).slots(), {}});
+    }
+
+    // Untimed warm-up, then each repeat times every decision policy in rotating order
+    const run_result_t &exact = rows[1].result;
+    const size_t timed = rows.size() - 1;
+    uint64_t sink = 0;
+    auto policy_of = [](const row_t &row) { return row.slots ? POLICY_MEMO : POLICY_EXACT; };
+    for (size_t k = 1; k < rows.size(); k++) time_decisions(exact.decision_queues, policy_of(rows[k]), 8, sink);
+    for (int rep = 0; rep < repeats; rep++) {
+        for (size_t k = 0; k < timed; k++) {
+            row_t &row = rows[1 + (rep + k) % timed];
+            row.batch_seconds.push_back(
+                time_decisions(exact.decision_queues, policy_of(row), row.slots ? row.slots : 8, sink));
+        }
+    }
+    auto decide_us = [](const row_t &row) {
+        return row.result.decisions ? median(row.batch_seconds) * 1e6 / row.result.decisions : 0.0;
+    };
+
+    cout << "\n" << left << setw(12) << "Policy" << right << setw(8) << "Slots" << setw(10) << "Mean wait"
+         << setw(6) << "p99" << setw(6) << "Max" << setw(11) << "Decisions" << setw(10) << "Hit rate"
+         << setw(11) << "Evictions" << setw(10) << "Full" << setw(13) << "us/decision" << setw(10) << "Run (s)"
+         << endl;
+    cout << string(107, '-') << endl;
+    bool all_same = true;
+    for (auto &row : rows) {
+        run_result_t &r = row.result;
+        bool same = row.name == "exact+memo" ? r.waits == exact.waits : true;
+        all_same &= same;
+        double mean = 0;
+        for (unsigned w : r.waits) mean += w;
+        mean /= max<size_t>(1, r.waits.size());
+        vector<unsigned> sorted = r.waits;
+        sort(sorted.begin(), sorted.end());
+        unsigned p99 = sorted.empty() ? 0 : sorted[(size_t)(0.99 * (sorted.size() - 1))];
+        unsigned worst = sorted.empty() ? 0 : sorted.back();
+
+        cout << left << setw(12) << row.name << right << setw(8) << (row.slots ? to_string(row.slots) : "-")
+             << fixed << setprecision(2) << setw(10) << mean << setw(6) << p99 << setw(6) << worst
+             << setw(11) << (row.name == "nearest" ? "-" : to_string(r.decisions));
+        if (row.slots) {
+            cout << setprecision(1) << setw(9) << 100.0 * r.counters.hits / max<uint64_t>(1, r.counters.lookups) << "%"
+                 << setw(11) << r.counters.evictions << setw(9) << 100.0 * r.occupied / row.slots << "%";
+        } else {
+            cout << setw(10) << "-" << setw(11) << "-" << setw(10) << "-";
+        }
+        cout << setprecision(3) << setw(13);
+        if (row.batch_seconds.empty()) cout << "-";
+        else cout << decide_us(row);
+        cout << setprecision(2) << setw(10) << r.seconds << (same ? "" : "  MISMATCH") << endl;
+    }
+    cout << "\nCached runs serve every call exactly as the uncached exact policy: " << (all_same ? "yes" : "NO")
+         << endl;
+
+    // Plain verdict for the default size, against the spread of the uncached batches
+    const row_t &memo = rows[default_row];
+    const vector<double> &exact_batches = rows[1].batch_seconds;
+    const double exact_us = decide_us(rows[1]), memo_us = decide_us(memo);
+    const double spread_us = (*max_element(exact_batches.begin(), exact_batches.end()) -
+                              *min_element(exact_batches.begin(), exact_batches.end())) *
+                             1e6 / max<uint64_t>(1, exact.decisions);
+    cout << "With " << memo.slots << " slots (" << setprecision(1)
+         << 100.0 * memo.result.counters.hits / max<uint64_t>(1, memo.result.counters.lookups)
+         << "% hits) a decision costs " << setprecision(3) << memo_us << " us against " << exact_us
+         << " us uncached (spread " << spread_us << " us): ";
+    if (memo_us < exact_us - spread_us) {
+        cout << "memoisation pays off at this load, " << setprecision(0) << 100 * (1 - memo_us / exact_us)
+             << "% less" << endl;
+    } else if (memo_us > exact_us + spread_us) {
+        cout << "memoisation costs more than it saves at this load" << endl;
+    } else {
+        cout << "no difference beyond the spread; memoisation does not pay off at this load" << endl;
+    }
+    return all_same && sink != 1 ? 0 : 1;
+}
@@ -0,0 +1,595 @@
+// Lock-free metrics exporter for multi-threaded controller runs
+// (host-side tool, not part of synthesis).
+//
+// Each worker thread is the control loop of one car. Every tick reads the
+// clock (for pacing and lateness against the tick schedule) and steps the
+// car's controller_transition. The instrumented loop counts the tick's
+// events with one add into a register of packed 12-bit fields: cycles
+// ending MOVING and DOOR_OPEN (from which moves, door openings and busy
+// cycles follow), accepted, requests and resets. Every
+// PUBLISH_INTERVAL ticks it publishes them to a cache-line-aligned slot that
+// only it writes (relaxed load + store, no read-modify-write, no sharing).
+// Rejected requests are derived at publication as requests minus accepted.
+// A reader sums the slots on demand, and a server thread answers each
+// connection on a Unix domain socket with the counters in the Prometheus
+// text exposition format, e.g.
+//   curl --unix-socket /tmp/elevator_metrics.sock http://localhost/metrics
+// Totals are exported fleet-wide; busy cycles and utilisation per car.
+//
+// The benchmark runs every car's live loop, paced at the tick period,
+// uninstrumented, with counters, and with counters while being scraped
+// every 100 ms (far more often than a monitoring system would). A tick's
+// latency runs from its due time to its finished step, wake-up included.
+// The tool exits non-zero if enabling export (counters and scraping,
+// against the uninstrumented loop) changes the median paced tick latency
+// by MAX_EXPORT_OVERHEAD or more; the tail is reported but is dominated by
+// the host's wake-up jitter. Variants run in rotating order within each
+// trial and medians are compared per trial. Each variant also runs its
+// ticks back to back for the CPU cost of a tick. That cost is reported
+// (per-trial median change, and the added CPU as a share of the tick
+// period) but not bounded: against a bare transition the counting shows,
+// since the bare loop never computes step.accepted, and it typically adds
+// a few percent to a tick that is mostly clock reads. The 1% bound is on
+// latency only. With more cars than cores the latency includes queueing
+// behind other cars and the check is not meaningful.
+//
+// Build: g++ -O2 -std=c++14 -pthread -I$XILINX_HLS/include elevator_hls.cpp elevator_metrics.cpp -o elevator_metrics
+// Usage: elevator_metrics [threads=min(4,cores)] [paced_ticks_per_trial=2000] [--trials 15] [--tick-us 100]
+//                         [--scrape-ms 100] [--serve seconds] [--socket path]
+
+#include "elevator_hls.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <time.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const int MAX_METRIC_THREADS = 64;
+static const uint64_t PUBLISH_INTERVAL = 2048;  // Ticks between publications; fits the 12-bit packed fields
+static const uint64_t BACK_TO_BACK_TICKS = 1000000;  // Per car per trial, for the CPU cost of a tick
+static const double MAX_EXPORT_OVERHEAD = 0.01;      // On the median paced tick latency, not CPU cost
+
+enum metric_id {
+    MET_STEPS = 0,
+    MET_REQUESTS,
+    MET_ACCEPTED,
+    MET_REJECTED,
+    MET_FLOORS_TRAVELLED,
+    MET_DOOR_OPENS,
+    MET_RESETS,
+    MET_BUSY_CYCLES,
+    MET_LATE_TICKS,
+    MET_LATENESS_NS,
+    NUM_METRICS
+};
+
+static const char *metric_names[NUM_METRICS] = {
+    "elevator_controller_steps_total",
+    "elevator_controller_requests_total",
+    "elevator_controller_accepted_total",
+    "elevator_controller_rejected_total",
+    "elevator_controller_floors_travelled_total",
+    "elevator_controller_door_opens_total",
+    "elevator_controller_resets_total",
+    "elevator_controller_busy_cycles_total",
+    "elevator_controller_late_ticks_total",
+    "elevator_controller_tick_lateness_seconds_total"
+};
+
+static const char *metric_help[NUM_METRICS] = {
+    "Controller cycles evaluated.",
+    "Valid requests presented to the controller.",
+    "Requests accepted by the controller.",
+    "Requests the controller did not accept (busy, same floor or out of range).",
+    "Floors moved by the car.",
+    "Door openings on arrival at a target.",
+    "Synchronous resets applied.",
+    "Cycles the car was not idle.",
+    "Ticks started a whole period or more after they were due.",
+    "Summed delay of tick starts behind the tick schedule."
+};
+
+// Exposition scale per metric (lateness is counted in ns, exported in seconds)
+static const double metric_scale[NUM_METRICS] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1e-9};
+
+// One thread's counters, on their own cache line so writers never share one
+struct alignas(64) thread_counters_t {
+    atomic<uint64_t> value[NUM_METRICS];
+};
+
+// Single-writer publication: a plain relaxed store is enough and avoids a locked RMW
+static inline void publish(thread_counters_t *counters, const uint64_t delta[NUM_METRICS]) {
+    for (int m = 0; m < NUM_METRICS; m++) {
+        atomic<uint64_t> &counter = counters->value[m];
+        counter.store(counter.load(memory_order_relaxed) + delta[m], memory_order_relaxed);
+    }
+}
+
+class MetricsRegistry {
+public:
+    MetricsRegistry() : registered(0), scrapes(0) {
+        for (int t = 0; t < MAX_METRIC_THREADS; t++) {
+            for (int m = 0; m < NUM_METRICS; m++) slots[t].value[m].store(0, memory_order_relaxed);
+        }
+    }
+
+    // Claim a slot for the calling thread; returns nullptr when all are taken
+    thread_counters_t *register_thread() {
+        int index = registered.fetch_add(1);
+        return index < MAX_METRIC_THREADS ? &slots[index] : nullptr;
+    }
+
+    // Aggregate on read; each slot is individually consistent, the sum is a snapshot in time
+    void snapshot(uint64_t totals[NUM_METRICS]) const {
+        int threads = min(registered.load(), MAX_METRIC_THREADS);
+        for (int m = 0; m < NUM_METRICS; m++) totals[m] = 0;
+        for (int t = 0; t < threads; t++) {
+            for (int m = 0; m < NUM_METRICS; m++) totals[m] += slots[t].value[m].load(memory_order_relaxed);
+        }
+    }
+
+    string exposition() {
+        uint64_t totals[NUM_METRICS];
+        snapshot(totals);
+        uint64_t scrape_count = scrapes.fetch_add(1) + 1;
+
+        ostringstream out;
+        for (int m = 0; m < NUM_METRICS; m++) {
+            out << "# HELP " << metric_names[m] << " " << metric_help[m] << "\n"
+                << "# TYPE " << metric_names[m] << " counter\n"
+                << metric_names[m] << " ";
+            if (metric_scale[m] == 1) out << totals[m] << "\n";
+            else out << totals[m] * metric_scale[m] << "\n";
+        }
+
+        // One worker thread drives one car
+        int threads = min(registered.load(), MAX_METRIC_THREADS);
+        out << "# HELP elevator_car_busy_cycles_total Cycles the car was not idle.\n"
+            << "# TYPE elevator_car_busy_cycles_total counter\n";
+        for (int t = 0; t < threads; t++) {
+            out << "elevator_car_busy_cycles_total{car=\"" << t << "\"} "
+                << slots[t].value[MET_BUSY_CYCLES].load(memory_order_relaxed) << "\n";
+        }
+        out << "# HELP elevator_car_utilisation Fraction of the car's cycles spent moving or with doors open.\n"
+            << "# TYPE elevator_car_utilisation gauge\n";
+        for (int t = 0; t < threads; t++) {
+            uint64_t steps = slots[t].value[MET_STEPS].load(memory_order_relaxed);
+            uint64_t busy = slots[t].value[MET_BUSY_CYCLES].load(memory_order_relaxed);
+            out << "elevator_car_utilisation{car=\"" << t << "\"} " << (steps ? (double)busy / steps : 0.0) << "\n";
+        }
+        out << "# HELP elevator_metrics_threads Worker threads registered.\n"
+            << "# TYPE elevator_metrics_threads gauge\n"
+            << "elevator_metrics_threads " << threads << "\n"
+            << "# HELP elevator_metrics_scrapes_total Expositions served.\n"
+            << "# TYPE elevator_metrics_scrapes_total counter\n"
+            << "elevator_metrics_scrapes_total " << scrape_count << "\n";
+        return out.str();
+    }
+
+private:
+    thread_counters_t slots[MAX_METRIC_THREADS];
+    atomic<int> registered;
+    atomic<uint64_t> scrapes;
+};
+
+static bool write_all(int fd, const string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        if (n <= 0) return false;
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// Serves one exposition per connection on a Unix domain socket
+class MetricsServer {
+public:
+    MetricsServer(MetricsRegistry &registry, const string &path)
+        : registry(registry), path(path), listen_fd(-1), running(false) {}
+
+    ~MetricsServer() { stop(); }
+
+    bool start() {
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) return false;
+
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(path.c_str());
+        if (bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 16) < 0) {
+            close(listen_fd);
+            listen_fd = -1;
+            return false;
+        }
+
+        running = true;
+        server = thread(&MetricsServer::serve, this);
+        return true;
+    }
+
+    void stop() {
+        if (!running) return;
+        running = false;
+        server.join();
+        close(listen_fd);
+        unlink(path.c_str());
+        listen_fd = -1;
+    }
+
+private:
+    void serve() {
+        while (running) {
+            pollfd pfd = {listen_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) continue;
+            int client = accept(listen_fd, nullptr, nullptr);
+            if (client < 0) continue;
+
+            // Consume the request line if the client sends one (HTTP scrapers do)
+            char request[1024];
+            pollfd cfd = {client, POLLIN, 0};
+            if (poll(&cfd, 1, 100) > 0) {
+                ssize_t ignored = read(client, request, sizeof(request));
+                (void)ignored;
+            }
+
+            string body = registry.exposition();
+            ostringstream response;
+            response << "HTTP/1.0 200 OK\r\n"
+                     << "Content-Type: text/plain; version=0.0.4\r\n"
+                     << "Content-Length: " << body.size() << "\r\n\r\n"
+                     << body;
+            write_all(client, response.str());
+            close(client);
+        }
+    }
+
+    MetricsRegistry &registry;
+    string path;
+    int listen_fd;
+    atomic<bool> running;
+    thread server;
+};
+
+// Fetch one exposition, as a scraper would; returns the body or an empty string
+static string scrape(const string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return "";
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    string response;
+    if (connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0 &&
+        write_all(fd, "GET /metrics HTTP/1.0\r\n\r\n")) {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0) response.append(buffer, (size_t)n);
+    }
+    close(fd);
+
+    size_t body = response.find("\r\n\r\n");
+    return body == string::npos ? "" : response.substr(body + 4);
+}
+
+static inline uint64_t monotonic_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// The controller moves one floor in exactly the cycles that end MOVING or
+// DOOR_OPEN, and its doors stay open for one cycle, so moves, door openings
+// and busy cycles all follow from how many cycles end in each state. Checked
+// over every reachable state and input before the counters are trusted.
+static bool state_counts_derive_events() {
+    vector<controller_state_t> frontier(1, CONTROLLER_RESET_STATE);
+    vector<bool> seen(1 << 16, false);
+    auto key = [](const controller_state_t &s) {
+        return s.floor | s.state << 4 | (s.direction + 1) << 6 | s.target << 8 | s.has_target << 12;
+    };
+    seen[key(CONTROLLER_RESET_STATE)] = true;
+    while (!frontier.empty()) {
+        controller_state_t s = frontier.back();
+        frontier.pop_back();
+        for (unsigned input = 0; input < 64; input++) {
+            bool valid = (input >> 4) & 1, reset = (input >> 5) & 1;
+            controller_state_t n = controller_transition(s, input & 15, valid, reset).next;
+            bool moved = n.floor != s.floor && !reset;
+            bool door_opened = n.state == CTRL_DOOR_OPEN && s.state != CTRL_DOOR_OPEN;
+            if (moved != (n.state != CTRL_IDLE) || door_opened != (n.state == CTRL_DOOR_OPEN)) return false;
+            if (!seen[key(n)]) {
+                seen[key(n)] = true;
+                frontier.push_back(n);
+            }
+        }
+    }
+    return true;
+}
+
+// 12-bit fields of the per-tick tally: cycles ending MOVING, cycles ending
+// DOOR_OPEN, accepted, requests, resets. Idle cycles are not counted.
+enum { TALLY_MOVING = 0, TALLY_DOOR_OPEN = 12, TALLY_ACCEPTED = 24, TALLY_REQUESTS = 36, TALLY_RESETS = 48 };
+static const uint64_t TALLY_STATE[4] = {0, 1ull << TALLY_MOVING, 1ull << TALLY_DOOR_OPEN, 0};
+
+static inline uint64_t tally_field(uint64_t tally, int field) { return (tally >> field) & 0xFFF; }
+
+// Control loop of one car on random inputs (xorshift, ~1/64 resets), with
+// ticks due every tick_ns. The live loop sleeps until each tick is due;
+// with Sleep = false the same ticks run back to back, ahead of the
+// schedule. Counters are optional. When latency_ns is given, each tick's
+// latency (due time to finished step) is stored there.
+template <bool Instrumented, bool Sleep>
+static uint64_t control_loop(thread_counters_t *counters, uint64_t ticks, uint32_t seed, uint64_t tick_ns,
+                             uint32_t *latency_ns = nullptr) {
+    controller_state_t s = CONTROLLER_RESET_STATE;
+    uint32_t x = seed | 1;
+    uint64_t checksum = 0;
+    uint64_t deadline = monotonic_ns();
+
+    for (uint64_t done = 0; done < ticks; done += PUBLISH_INTERVAL) {
+        uint64_t chunk = min(PUBLISH_INTERVAL, ticks - done);
+        // One register-resident tally for the chunk; the slot is only touched once per chunk
+        uint64_t tally = 0, late_ticks = 0, lateness = 0;
+
+        for (uint64_t i = 0; i < chunk; i++) {
+            if (Sleep) {
+                timespec due = {(time_t)(deadline / 1000000000ull), (long)(deadline % 1000000000ull)};
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr);
+            }
+            uint64_t now = monotonic_ns(), due = deadline;
+            if (Instrumented && now > due) {
+                lateness += now - due;
+                late_ticks += now - due >= tick_ns;
+            }
+            deadline += tick_ns;
+
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            bool reset = ((x >> 8) & 63) == 0;
+            bool valid = (x >> 4) & 1;
+            controller_step_t step = controller_transition(s, x & 15, valid, reset);
+
+            if (Instrumented) {
+                tally += TALLY_STATE[step.next.state & 3] | (uint64_t)step.accepted << TALLY_ACCEPTED |
+                         (uint64_t)(valid & !reset) << TALLY_REQUESTS | (uint64_t)reset << TALLY_RESETS;
+            }
+
+            s = step.next;
+            checksum += s.floor;
+            if (latency_ns) latency_ns[done + i] = (uint32_t)min<uint64_t>(monotonic_ns() - due, UINT32_MAX);
+        }
+
+        if (Instrumented && counters) {
+            uint64_t moving = tally_field(tally, TALLY_MOVING), door_open = tally_field(tally, TALLY_DOOR_OPEN);
+            uint64_t accepted = tally_field(tally, TALLY_ACCEPTED), requests = tally_field(tally, TALLY_REQUESTS);
+            uint64_t delta[NUM_METRICS] = {chunk, requests, accepted, requests - accepted, moving + door_open,
+                                           door_open, tally_field(tally, TALLY_RESETS), moving + door_open,
+                                           late_ticks, lateness};
+            publish(counters, delta);
+        }
+    }
+    return checksum;
+}
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+template <typename T>
+static double percentile(vector<T> v, double q) {
+    size_t k = (size_t)(q * (v.size() - 1));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return (double)v[k];
+}
+
+// One benchmark variant: CPU time per tick with the ticks run back to back
+// (worker CPU time, so a scraper sharing the core shows up only through the
+// interference it causes), and per-tick latencies of the paced live loop
+struct variant_result_t {
+    double cpu_ns = 0;
+    vector<uint32_t> latency_ns;  // All trials
+    vector<double> trial_p50_ns;
+    vector<double> trial_cpu_ns;
+};
+
+template <bool Instrumented>
+static void run_variant(int threads, uint64_t back_to_back, uint64_t paced, uint64_t tick_ns, int trials,
+                        MetricsRegistry *registry, variant_result_t &result) {
+    vector<thread> workers;
+    vector<uint64_t> checksums(threads);
+    vector<double> cpu_ns(threads);
+    vector<vector<uint32_t> > latency(threads, vector<uint32_t>(paced));
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            thread_counters_t *counters = Instrumented ? registry->register_thread() : nullptr;
+            uint32_t seed = 0x9e3779b9u * (t + 1);
+            double start = thread_cpu_ns();
+            checksums[t] = control_loop<Instrumented, false>(counters, back_to_back, seed, tick_ns);
+            cpu_ns[t] = thread_cpu_ns() - start;
+            checksums[t] += control_loop<Instrumented, true>(counters, paced, seed + 1, tick_ns, latency[t].data());
+        }));
+    }
+    for (auto &w : workers) w.join();
+
+    volatile uint64_t sink = 0;
+    for (uint64_t c : checksums) sink += c;
+    (void)sink;
+
+    vector<uint32_t> trial;
+    double trial_cpu_ns = 0;
+    for (int t = 0; t < threads; t++) {
+        trial_cpu_ns += cpu_ns[t] / ((double)threads * back_to_back);
+        trial.insert(trial.end(), latency[t].begin(), latency[t].end());
+    }
+    result.cpu_ns += trial_cpu_ns / trials;
+    result.trial_cpu_ns.push_back(trial_cpu_ns);
+    result.latency_ns.insert(result.latency_ns.end(), trial.begin(), trial.end());
+    result.trial_p50_ns.push_back(percentile(trial, 0.5));
+}
+
+int main(int argc, char **argv) {
+    // One car per core by default: cars beyond the cores wake together and queue behind each other
+    int threads = (int)max(1u, min(4u, thread::hardware_concurrency()));
+    uint64_t paced = 2000;
+    int trials = 15;
+    int serve_seconds = 0;
+    int scrape_ms = 100;
+    uint64_t tick_us = 100;
+    string socket_path = "/tmp/elevator_metrics.sock";
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--serve") && i + 1 < argc) serve_seconds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--trials") && i + 1 < argc) trials = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--scrape-ms") && i + 1 < argc) scrape_ms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--tick-us") && i + 1 < argc) tick_us = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--socket") && i + 1 < argc) socket_path = argv[++i];
+        else if (positional++ == 0) threads = atoi(argv[i]);
+        else paced = strtoull(argv[i], nullptr, 10);
+    }
+    if (threads < 1 || threads > MAX_METRIC_THREADS || trials < 1 || paced == 0 || tick_us == 0) {
+        cerr << "threads must be in 1.." << MAX_METRIC_THREADS << ", trials, ticks and tick-us positive" << endl;
+        return 1;
+    }
+    if (!state_counts_derive_events()) {
+        cerr << "Controller events no longer follow from state counts; update control_loop" << endl;
+        return 1;
+    }
+    const uint64_t tick_ns = tick_us * 1000;
+    if ((unsigned)threads > thread::hardware_concurrency()) {
+        cout << "Note: more cars than cores; tick latency includes waiting for the other cars" << endl;
+    }
+
+    cout << "=== Controller Metrics Export Benchmark ===" << endl;
+    cout << threads << " cars (threads), " << trials << " trials of " << paced << " ticks at " << tick_us
+         << " us plus " << BACK_TO_BACK_TICKS << " back to back" << endl;
+
+    const char *labels[3] = {"uninstrumented", "per-thread counters", nullptr};
+    string exported_label = "counters + " + to_string(scrape_ms) + " ms scrapes";
+    labels[2] = exported_label.c_str();
+    variant_result_t results[3];
+    uint64_t scrapes = 0;
+    bool exposition_ok = true;
+    for (int trial = 0; trial < trials; trial++) {
+        // Rotate the order of the variants so drift affects each equally
+        for (int k = 0; k < 3; k++) {
+            int variant = (trial + k) % 3;
+            if (variant == 0) {
+                run_variant<false>(threads, BACK_TO_BACK_TICKS, paced, tick_ns, trials, nullptr, results[0]);
+            } else if (variant == 1) {
+                MetricsRegistry quiet;
+                run_variant<true>(threads, BACK_TO_BACK_TICKS, paced, tick_ns, trials, &quiet, results[1]);
+            } else {
+                MetricsRegistry registry;
+                MetricsServer server(registry, socket_path);
+                if (!server.start()) {
+                    cerr << "Cannot listen on " << socket_path << endl;
+                    return 1;
+                }
+                atomic<bool> done(false);
+                thread scraper([&]() {
+                    while (!done) {
+                        string body = scrape(socket_path);
+                        if (body.find(metric_names[MET_STEPS]) == string::npos ||
+                            body.find("# TYPE elevator_car_utilisation gauge") == string::npos) {
+                            exposition_ok = false;
+                        }
+                        scrapes++;
+                        this_thread::sleep_for(chrono::milliseconds(scrape_ms));
+                    }
+                });
+                run_variant<true>(threads, BACK_TO_BACK_TICKS, paced, tick_ns, trials, &registry, results[2]);
+                done = true;
+                scraper.join();
+
+                uint64_t totals[NUM_METRICS];
+                registry.snapshot(totals);
+                if (totals[MET_STEPS] != (uint64_t)threads * (BACK_TO_BACK_TICKS + paced) ||
+                    totals[MET_ACCEPTED] + totals[MET_REJECTED] != totals[MET_REQUESTS]) {
+                    exposition_ok = false;
+                }
+            }
+        }
+    }
+
+    // Medians are compared trial by trial, so drift in wake-up latency between trials cancels
+    double p50[3], p99[3], p50_change[3], cpu_change[3];
+    for (int v = 0; v < 3; v++) {
+        p50[v] = percentile(results[v].latency_ns, 0.50) / 1000;
+        p99[v] = percentile(results[v].latency_ns, 0.99) / 1000;
+        vector<double> ratios(trials), cpu_ratios(trials);
+        for (int t = 0; t < trials; t++) {
+            ratios[t] = results[v].trial_p50_ns[t] / results[0].trial_p50_ns[t];
+            cpu_ratios[t] = results[v].trial_cpu_ns[t] / results[0].trial_cpu_ns[t];
+        }
+        p50_change[v] = percentile(ratios, 0.5) - 1;
+        cpu_change[v] = percentile(cpu_ratios, 0.5) - 1;
+    }
+    cout << "\n" << left << setw(30) << "Variant" << right << setw(14) << "CPU ns/tick" << setw(10) << "vs plain"
+         << setw(16) << "p50 latency us" << setw(10) << "vs plain" << setw(16) << "p99 latency us" << endl;
+    cout << string(96, '-') << endl;
+    cout << fixed << setprecision(3);
+    for (int v = 0; v < 3; v++) {
+        cout << left << setw(30) << labels[v] << right << setw(14) << results[v].cpu_ns << setw(9)
+             << 100.0 * cpu_change[v] << "%" << setw(16) << p50[v] << setw(9)
+             << 100.0 * p50_change[v] << "%" << setw(16) << p99[v] << endl;
+    }
+
+    double export_overhead = p50_change[2];
+    bool within_bound = export_overhead < MAX_EXPORT_OVERHEAD;
+    cout << "\n" << scrapes << " scrapes, expositions " << (exposition_ok ? "consistent" : "INCONSISTENT") << endl;
+    cout << "Enabling export changes back-to-back CPU per tick by " << 100.0 * cpu_change[2] << "% ("
+         << cpu_change[2] * results[0].cpu_ns << " ns, " << setprecision(4)
+         << 100.0 * cpu_change[2] * results[0].cpu_ns / tick_ns << "% of the tick period); not bounded"
+         << endl;
+    cout << setprecision(3) << "Enabling export changes median paced tick latency by " << 100.0 * export_overhead
+         << "%, bound " << 100.0 * MAX_EXPORT_OVERHEAD << "% (applies to this latency): "
+         << (within_bound ? "PASS" : "FAIL") << endl;
+
+    if (serve_seconds > 0) {
+        // Keep the cars running at the tick rate so an external scraper can be pointed at the socket
+        MetricsRegistry registry;
+        MetricsServer server(registry, socket_path);
+        if (!server.start()) {
+            cerr << "Cannot listen on " << socket_path << endl;
+            return 1;
+        }
+        cout << "\nServing " << socket_path << " for " << serve_seconds << "s, " << tick_us << " us ticks" << endl;
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(serve_seconds);
+        const uint64_t chunk_ticks = max<uint64_t>(1, 100000 / tick_us);  // About 0.1 s per call
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.push_back(thread([&, t]() {
+                thread_counters_t *counters = registry.register_thread();
+                for (uint32_t chunk = 1; chrono::steady_clock::now() < deadline; chunk++) {
+                    control_loop<true, true>(counters, chunk_ticks, 0x9e3779b9u * (t + 1) + chunk, tick_ns);
+                }
+            }));
+        }
+        for (auto &w : workers) w.join();
+    }
+
+    return exposition_ok && within_bound ? 0 : 1;
+}
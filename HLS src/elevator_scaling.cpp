@@ -0,0 +1,264 @@
+// Strong and weak scaling report for parallel controller simulation
+// (host-side tool, not part of synthesis).
+//
+// Each worker thread simulates batches of independent controller runs: it
+// allocates an input trace, steps controller_transition over it, folds the
+// results into totals shared by all threads, and appends a summary line to
+// a shared log. This is the C++ batch driver for the synthesised
+// controller; the Python process pools are measured alongside the socket
+// report in numa_sharding.py (pool_scaling_report). The trace is allocated
+// and released inside the timed step on purpose, once per batch, so that
+// allocator contention shows up. Every phase is timed per thread, so the
+// report shows where scaling is lost:
+//   alloc    - trace allocation and release (allocator contention)
+//   compute  - input generation and controller steps (the useful work)
+//   counters - updates of the shared totals (mutex and cache-line contention)
+//   io       - writes to the shared batch log (stdio lock and the kernel)
+//   idle     - time a thread waited for the slowest one (load imbalance)
+//   offcpu   - part of the phases above spent blocked or descheduled rather
+//              than running (lock waits, page faults, oversubscription)
+// Strong scaling keeps the total number of batches fixed; weak scaling keeps
+// the batches per thread fixed. Every thread count from 1 to max_threads is
+// run, or every --step'th one (max_threads is always included).
+// --hot-counters bumps a shared atomic every step instead of once per
+// batch, to show what a contended counter costs.
+//
+// Build: g++ -O2 -std=c++14 -pthread -I$XILINX_HLS/include elevator_hls.cpp elevator_scaling.cpp -o elevator_scaling
+// Usage: elevator_scaling [max_threads=hardware] [batches=256] [steps_per_batch=100000]
+//                         [--step n] [--hot-counters] [--log path]
+
+#include "elevator_hls.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <time.h>
+
+using namespace std;
+
+enum phase_id {
+    PH_ALLOC = 0,
+    PH_COMPUTE,
+    PH_COUNTERS,
+    PH_IO,
+    NUM_PHASES
+};
+
+static const char *phase_names[NUM_PHASES] = {"alloc", "compute", "counters", "io"};
+
+struct step_input_t {
+    uint8_t floor;
+    uint8_t valid;
+    uint8_t reset;
+};
+
+// Totals shared by every worker, as a real batch driver would keep them
+struct shared_totals_t {
+    mutex lock;
+    uint64_t events = 0;
+    uint64_t accepted = 0;
+    uint64_t floor_histogram[16] = {0};
+    atomic<uint64_t> hot_events{0};
+};
+
+struct thread_times_t {
+    double phase[NUM_PHASES] = {0};
+    double busy = 0;
+    double cpu = 0;
+    uint64_t events = 0;
+};
+
+struct run_config_t {
+    uint64_t steps_per_batch;
+    bool hot_counters;
+    FILE *log;
+};
+
+static inline double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static double thread_cpu_seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void worker(int id, int batches, const run_config_t &config, shared_totals_t &totals,
+                   thread_times_t &times) {
+    uint32_t x = 0x9e3779b9u * (id + 1) | 1;
+    auto thread_start = chrono::steady_clock::now();
+    double cpu_start = thread_cpu_seconds();
+
+    for (int b = 0; b < batches; b++) {
+        auto t = chrono::steady_clock::now();
+        auto trace = make_unique<vector<step_input_t>>(config.steps_per_batch);
+        times.phase[PH_ALLOC] += seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        for (auto &input : *trace) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            input.floor = x & 15;
+            input.valid = (x >> 4) & 1;
+            input.reset = ((x >> 8) & 1023) == 0;
+        }
+        controller_state_t s = CONTROLLER_RESET_STATE;
+        uint64_t accepted = 0;
+        uint64_t histogram[16] = {0};
+        for (const auto &input : *trace) {
+            controller_step_t step = controller_transition(s, input.floor, input.valid, input.reset);
+            s = step.next;
+            accepted += step.accepted;
+            histogram[s.floor & 15]++;
+            if (config.hot_counters) totals.hot_events.fetch_add(1, memory_order_relaxed);
+        }
+        times.phase[PH_COMPUTE] += seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        {
+            lock_guard<mutex> guard(totals.lock);
+            totals.events += trace->size();
+            totals.accepted += accepted;
+            for (int f = 0; f < 16; f++) totals.floor_histogram[f] += histogram[f];
+        }
+        times.phase[PH_COUNTERS] += seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        fprintf(config.log, "thread %d batch %d steps %zu accepted %llu final_floor %u\n",
+                id, b, trace->size(), (unsigned long long)accepted, (unsigned)s.floor);
+        fflush(config.log);
+        times.phase[PH_IO] += seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        trace.reset();
+        times.phase[PH_ALLOC] += seconds_since(t);
+
+        times.events += config.steps_per_batch;
+    }
+    times.busy = seconds_since(thread_start);
+    times.cpu = thread_cpu_seconds() - cpu_start;
+}
+
+struct scaling_row_t {
+    int threads;
+    double wall;
+    uint64_t events;
+    double phase[NUM_PHASES];  // Mean seconds per thread
+    double idle;
+    double offcpu;
+};
+
+static scaling_row_t run_threads(int threads, int total_batches, const run_config_t &config) {
+    shared_totals_t totals;
+    vector<thread_times_t> times(threads);
+    vector<thread> workers;
+
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        // Spread the batches as evenly as possible; the remainder goes to the first threads
+        int batches = total_batches / threads + (t < total_batches % threads ? 1 : 0);
+        workers.push_back(thread(worker, t, batches, cref(config), ref(totals), ref(times[t])));
+    }
+    for (auto &w : workers) w.join();
+
+    scaling_row_t row;
+    row.threads = threads;
+    row.wall = seconds_since(start);
+    row.events = totals.events;
+    row.idle = 0;
+    row.offcpu = 0;
+    for (int p = 0; p < NUM_PHASES; p++) row.phase[p] = 0;
+    for (const auto &tt : times) {
+        for (int p = 0; p < NUM_PHASES; p++) row.phase[p] += tt.phase[p] / threads;
+        row.idle += max(0.0, row.wall - tt.busy) / threads;
+        row.offcpu += max(0.0, tt.busy - tt.cpu) / threads;
+    }
+    return row;
+}
+
+static void print_report(const char *title, const vector<scaling_row_t> &rows, bool weak) {
+    cout << "\n" << title << endl;
+    cout << left << setw(9) << "Threads" << right << setw(10) << "Wall (s)" << setw(10) << "Speedup"
+         << setw(12) << "Efficiency" << setw(16) << "Mevents/s/thr";
+    for (int p = 0; p < NUM_PHASES; p++) cout << setw(10) << phase_names[p];
+    cout << setw(10) << "idle" << setw(10) << "offcpu" << endl;
+
+    const scaling_row_t &base = rows.front();
+    for (const auto &row : rows) {
+        // Strong: T1/TN against ideal N. Weak: scaled speedup N*T1/TN against ideal N.
+        double speedup = weak ? row.threads * base.wall / row.wall : base.wall / row.wall;
+        double efficiency = speedup / row.threads;
+        double per_thread = row.events / row.wall / row.threads / 1e6;
+
+        cout << left << setw(9) << row.threads << right << fixed << setprecision(3) << setw(10) << row.wall
+             << setprecision(2) << setw(10) << speedup << setw(11) << efficiency * 100 << "%"
+             << setw(16) << per_thread;
+        // Breakdown as a share of wall time, averaged over threads
+        for (int p = 0; p < NUM_PHASES; p++) cout << setw(9) << 100 * row.phase[p] / row.wall << "%";
+        cout << setw(9) << 100 * row.idle / row.wall << "%"
+             << setw(9) << 100 * row.offcpu / row.wall << "%" << endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    int max_threads = (int)max(1u, thread::hardware_concurrency());
+    int batches = 256;
+    int step = 1;
+    uint64_t steps_per_batch = 100000;
+    bool hot_counters = false;
+    const char *log_path = "/tmp/elevator_scaling.log";
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--hot-counters")) hot_counters = true;
+        else if (!strcmp(argv[i], "--log") && i + 1 < argc) log_path = argv[++i];
+        else if (!strcmp(argv[i], "--step") && i + 1 < argc) step = atoi(argv[++i]);
+        else if (positional == 0) { max_threads = atoi(argv[i]); positional++; }
+        else if (positional == 1) { batches = atoi(argv[i]); positional++; }
+        else steps_per_batch = strtoull(argv[i], nullptr, 10);
+    }
+    if (max_threads < 1 || batches < 1 || step < 1) {
+        cerr << "threads, batches and step must be positive" << endl;
+        return 1;
+    }
+
+    FILE *log = fopen(log_path, "w");
+    if (!log) {
+        cerr << "Cannot open " << log_path << endl;
+        return 1;
+    }
+    run_config_t config = {steps_per_batch, hot_counters, log};
+
+    vector<int> counts;
+    for (int n = 1; n < max_threads; n += step) counts.push_back(n);
+    counts.push_back(max_threads);
+
+    cout << "=== Parallel Simulation Scaling Report ===" << endl;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << ", batch: " << steps_per_batch
+         << " steps, shared counters " << (hot_counters ? "per step (hot)" : "per batch")
+         << ", log " << log_path << endl;
+    cout << "Breakdown columns: mean share of wall time per thread" << endl;
+
+    vector<scaling_row_t> strong, weak;
+    int weak_batches = max(1, batches / max_threads);
+    for (int n : counts) {
+        strong.push_back(run_threads(n, batches, config));
+        weak.push_back(run_threads(n, weak_batches * n, config));
+    }
+    fclose(log);
+
+    print_report(("Strong scaling (" + to_string(batches) + " batches total)").c_str(), strong, false);
+    print_report(("Weak scaling (" + to_string(weak_batches) + " batches per thread)").c_str(), weak, true);
+    return 0;
+}
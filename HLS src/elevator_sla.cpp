@@ -0,0 +1,177 @@
+// Per-floor SLA attainment for the dispatch policies in elevator_hls.h
+// (host-side tool, not part of synthesis).
+//
+// Random hall calls are fed through the same constexpr transitions the
+// synthesised controllers register, one call per cycle at most, and every
+// served call's wait is checked against its floor's FLOOR_SLA deadline:
+//   nearest      - dispatch_calls, nearest-first with no age limit
+//   age-limit    - dispatch_calls with CALL_AGE_LIMIT promotion
+//   sweep        - sla_dispatch_calls with no deadlines (plain sweep order)
+//   sweep+EDF    - sla_dispatch_calls against FLOOR_SLA, with age_limit
+//                  promotion (default CALL_AGE_LIMIT) bounding missed calls
+// A call's wait runs from its first press until doors open at its floor;
+// presses on a floor that is already pending merge into the waiting call.
+//
+// Build: g++ -O2 -std=c++14 -I$XILINX_HLS/include elevator_hls.cpp elevator_sla.cpp -o elevator_sla
+// Usage: elevator_sla [calls_per_cycle=0.2] [cycles=2000000] [lobby_share=0.25] [age_limit=64]
+
+#include "elevator_hls.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+enum policy_id {
+    POLICY_NEAREST = 0,
+    POLICY_AGE_LIMIT,
+    POLICY_SWEEP,
+    POLICY_EDF,
+    NUM_POLICIES
+};
+
+static const char *policy_names[NUM_POLICIES] = {"nearest", "age-limit", "sweep", "sweep+EDF"};
+
+constexpr sla_table_t NO_SLA = {{0}};
+
+struct floor_stats_t {
+    uint64_t served = 0;
+    uint64_t met = 0;
+    uint64_t total_wait = 0;
+    unsigned max_wait = 0;
+};
+
+struct policy_result_t {
+    floor_stats_t floors[CALL_FLOORS];
+    uint64_t overrides = 0;
+    vector<unsigned> waits;
+};
+
+static inline uint32_t xorshift(uint32_t &x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+static policy_result_t run_policy(int policy, double rate, uint64_t cycles, double lobby_share,
+                                  unsigned edf_age_limit) {
+    policy_result_t result;
+    uint32_t x = 0x2545f491u;  // Same call sequence for every policy
+    const uint32_t threshold = (uint32_t)(rate * 4294967295.0);
+    const uint32_t lobby_threshold = (uint32_t)(lobby_share * 4294967295.0);
+
+    call_queue_t q = CALL_QUEUE_RESET_STATE;
+    for (uint64_t c = 0; c < cycles; c++) {
+        unsigned new_calls = 0;
+        if (xorshift(x) < threshold) {
+            unsigned floor = xorshift(x) < lobby_threshold ? 1 : 2 + xorshift(x) % (CALL_FLOORS - 2);
+            new_calls = 1u << floor;
+        }
+
+        dispatch_step_t step{};
+        switch (policy) {
+            case POLICY_NEAREST: step = dispatch_calls(q, new_calls, false, CALL_AGE_MAX); break;
+            case POLICY_AGE_LIMIT: step = dispatch_calls(q, new_calls, false, CALL_AGE_LIMIT); break;
+            case POLICY_SWEEP: step = sla_dispatch_calls(q, new_calls, false, NO_SLA, CALL_AGE_MAX).dispatch; break;
+            default: step = sla_dispatch_calls(q, new_calls, false, FLOOR_SLA, edf_age_limit).dispatch; break;
+        }
+        result.overrides += step.promoted;
+
+        // Calls pending before this cycle, or pressed in it, that are no longer pending
+        unsigned served = (q.pending | new_calls) & ~step.next.pending & CALL_FLOOR_MASK;
+        for (int f = 1; f < CALL_FLOORS; f++) {
+            if ((served >> f) & 1) {
+                unsigned wait = ((q.pending >> f) & 1) ? q.age[f] + 1u : 0u;
+                floor_stats_t &stats = result.floors[f];
+                stats.served++;
+                stats.met += FLOOR_SLA.deadline[f] == 0 || wait <= FLOOR_SLA.deadline[f];
+                stats.total_wait += wait;
+                stats.max_wait = max(stats.max_wait, wait);
+                result.waits.push_back(wait);
+            }
+        }
+        q = step.next;
+    }
+    return result;
+}
+
+int main(int argc, char **argv) {
+    double rate = argc > 1 ? atof(argv[1]) : 0.2;
+    uint64_t cycles = argc > 2 ? strtoull(argv[2], nullptr, 10) : 2000000;
+    double lobby_share = argc > 3 ? atof(argv[3]) : 0.25;
+    unsigned age_limit = argc > 4 ? (unsigned)atoi(argv[4]) : CALL_AGE_LIMIT;
+    if (rate <= 0 || rate > 1 || cycles == 0) {
+        cerr << "calls_per_cycle must be in (0, 1] and cycles positive" << endl;
+        return 1;
+    }
+
+    cout << "=== Per-Floor SLA Attainment ===" << endl;
+    cout << "Calls per cycle: " << rate << ", cycles: " << cycles << ", lobby share: " << lobby_share
+         << ", EDF age limit: " << age_limit << endl;
+
+    vector<policy_result_t> results;
+    for (int p = 0; p < NUM_POLICIES; p++) results.push_back(run_policy(p, rate, cycles, lobby_share, age_limit));
+
+    cout << "\nShare of calls served within the floor's deadline (cycles)" << endl;
+    cout << left << setw(7) << "Floor" << right << setw(10) << "Deadline";
+    for (int p = 0; p < NUM_POLICIES; p++) cout << setw(12) << policy_names[p];
+    cout << endl;
+
+    cout << fixed << setprecision(1);
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (FLOOR_SLA.deadline[f] == 0) continue;
+        cout << left << setw(7) << f << right << setw(10) << FLOOR_SLA.deadline[f];
+        for (const auto &r : results) {
+            const floor_stats_t &s = r.floors[f];
+            cout << setw(11) << (s.served ? 100.0 * s.met / s.served : 100.0) << "%";
+        }
+        cout << endl;
+    }
+
+    // Summary: overall attainment, the premium floors, and the wait distribution
+    cout << "\n" << left << setw(17) << "Summary";
+    for (int p = 0; p < NUM_POLICIES; p++) cout << right << setw(12) << policy_names[p];
+    cout << endl;
+
+    const char *rows[] = {"All floors", "Tightest SLA", "Mean wait", "p99 wait", "Max wait", "EDF/age overrides"};
+    unsigned short tightest = SLA_DEADLINE_MAX;
+    for (int f = 1; f < CALL_FLOORS; f++) {
+        if (FLOOR_SLA.deadline[f]) tightest = min(tightest, FLOOR_SLA.deadline[f]);
+    }
+    for (int row = 0; row < 6; row++) {
+        cout << left << setw(17) << rows[row] << right;
+        for (auto &r : results) {
+            uint64_t served = 0, met = 0, tight_served = 0, tight_met = 0, total_wait = 0;
+            unsigned max_wait = 0;
+            for (int f = 1; f < CALL_FLOORS; f++) {
+                served += r.floors[f].served;
+                met += r.floors[f].met;
+                total_wait += r.floors[f].total_wait;
+                max_wait = max(max_wait, r.floors[f].max_wait);
+                if (FLOOR_SLA.deadline[f] == tightest) {
+                    tight_served += r.floors[f].served;
+                    tight_met += r.floors[f].met;
+                }
+            }
+            switch (row) {
+                case 0: cout << setw(11) << 100.0 * met / max<uint64_t>(1, served) << "%"; break;
+                case 1: cout << setw(11) << 100.0 * tight_met / max<uint64_t>(1, tight_served) << "%"; break;
+                case 2: cout << setw(12) << (double)total_wait / max<uint64_t>(1, served); break;
+                case 3: {
+                    size_t k = r.waits.empty() ? 0 : (size_t)(0.99 * (r.waits.size() - 1));
+                    if (!r.waits.empty()) nth_element(r.waits.begin(), r.waits.begin() + k, r.waits.end());
+                    cout << setw(12) << (r.waits.empty() ? 0u : r.waits[k]);
+                    break;
+                }
+                case 4: cout << setw(12) << max_wait; break;
+                default: cout << setw(12) << r.overrides; break;
+            }
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Request trace format shared by the host-side replay tools (not part of synthesis).
+//
+// A trace file is a 16-byte header followed by fixed 16-byte records, one
+// per cycle in which the controller's request or reset input is active,
+// in strictly increasing cycle order. Between records the controller sees
+// no request.
+#ifndef ELEVATOR_TRACE_H
+#define ELEVATOR_TRACE_H
+
+#include "elevator_hls.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+struct trace_header_t {
+    char magic[8];
+    uint64_t records;
+};
+
+struct trace_record_t {
+    uint64_t cycle;
+    uint8_t floor;
+    uint8_t flags;  // TRACE_VALID | TRACE_RESET
+    uint8_t reserved[6];
+};
+static_assert(sizeof(trace_header_t) == 16 && sizeof(trace_record_t) == 16, "fixed 16-byte trace layout");
+
+enum { TRACE_VALID = 1, TRACE_RESET = 2 };
+
+static const char TRACE_MAGIC[8] = {'E', 'L', 'V', 'T', 'R', 'C', '1', '\0'};
+
+// Synthetic trace: a request every 1-32 cycles, mostly valid floors, rare resets
+inline bool write_synthetic_trace(const char *path, uint64_t records, uint32_t seed = 0x3c6ef372u) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    trace_header_t header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.records = records;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+    static trace_record_t buffer[4096];
+    uint32_t x = seed | 1;
+    uint64_t cycle = 0;
+    for (uint64_t written = 0; ok && written < records;) {
+        size_t n = 0;
+        for (; n < 4096 && written + n < records; n++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            cycle += 1 + (x & 31);
+            trace_record_t &r = buffer[n];
+            memset(&r, 0, sizeof(r));
+            r.cycle = cycle;
+            r.floor = (uint8_t)((x >> 5) & 15);
+            r.flags = (uint8_t)((((x >> 9) & 7) != 0 ? TRACE_VALID : 0) | (((x >> 12) & 8191) == 0 ? TRACE_RESET : 0));
+        }
+        ok = fwrite(buffer, sizeof(trace_record_t), n, f) == n;
+        written += n;
+    }
+    return fclose(f) == 0 && ok;
+}
+
+// Controller state while replaying a trace
+struct trace_replay_t {
+    controller_state_t s;
+    uint64_t cycle;     // Next cycle to simulate
+    uint64_t records;
+    uint64_t accepted;
+    uint64_t checksum;  // Folds the floor after every record, to compare replays
+};
+
+inline trace_replay_t trace_replay_start() {
+    return trace_replay_t{CONTROLLER_RESET_STATE, 0, 0, 0, 0};
+}
+
+// Step through the quiet cycles up to the record, then the record's cycle.
+// An idle controller with no target is a fixed point of a quiet cycle, so
+// the rest of a gap is skipped once it gets there.
+inline void trace_replay(trace_replay_t &r, const trace_record_t &record) {
+    while (r.cycle < record.cycle && !(r.s.state == CTRL_IDLE && !r.s.has_target)) {
+        r.s = controller_transition(r.s, 0, false, false).next;
+        r.cycle++;
+    }
+    controller_step_t step = controller_transition(r.s, record.floor, (record.flags & TRACE_VALID) != 0,
+                                                   (record.flags & TRACE_RESET) != 0);
+    r.s = step.next;
+    r.cycle = record.cycle + 1;
+    r.records++;
+    r.accepted += step.accepted;
+    r.checksum = r.checksum * 31 + r.s.floor;
+}
+
+#endif
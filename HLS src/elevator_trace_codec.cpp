@@ -0,0 +1,740 @@
+// Block-compressed request traces with SIMD decoding and time-range seeks
+// (host-side tool, not part of synthesis).
+//
+// A raw trace (elevator_trace.h, 16 bytes per record) is cut into blocks of
+// up to block_records records. Each block stores two bit-packed streams at
+// the narrowest width its values need:
+//   deltas - cycle[i] - cycle[i-1] - 1 (cycles strictly increase, so the
+//            delta is never negative and needs no zigzag); 0 for record 0
+//   fields - floor | flags << 4
+// Values are packed lane-interleaved: value i belongs to lane i % 8, and
+// each lane's bits run through every eighth 32-bit word. All eight lanes of
+// a group then sit at the same bit offset, so one vector shift and mask
+// unpacks eight values (AVX2, or two SSE2 halves); the scalar decoder is
+// kept as the reference.
+//
+// The file ends with an index of every block's cycle range, file offset,
+// and a checkpoint of the replayed controller state at the block's first
+// record. A time-range query binary-searches the index, reads only the
+// overlapping blocks, and resumes the replay from the checkpoint, so its
+// controller states match a full replay exactly.
+//
+// Encoding streams: it reads block_records raw records at a time, writes
+// the block and appends its index entry, and writes the index and footer at
+// the end, checking the record count against the raw header. Records must
+// have strictly increasing cycles and floors that fit the 4-bit field.
+// Every pass below likewise works from the files one block or chunk at a
+// time.
+//
+// Full replays from the block file decode off the replay thread: a decoder
+// thread reads and decodes blocks into a small ring ahead of the replay,
+// which only waits when the ring is empty, so decompression never limits
+// replay while a core is free for the decoder. On a single core the two
+// threads share it and decode time adds to replay time.
+//
+// The report gives the compression ratio, scalar and SIMD decode rates
+// (decoding alone), and end-to-end throughput of reading and replaying the
+// raw file against reading, decoding and replaying the block file, followed
+// by a range query. The end-to-end passes are warmed up and then alternated
+// over several repeats; the spread of the raw-file repeats is the noise band
+// the block file's difference is judged against.
+//
+// Build: g++ -O2 -std=c++14 [-mavx2] -pthread -I$XILINX_HLS/include elevator_hls.cpp elevator_trace_codec.cpp -o elevator_trace_codec
+// Usage: elevator_trace_codec trace_path [--generate records] [--block 4096] [--from cycle] [--to cycle]
+//                             [--repeats 5]
+
+#include "elevator_trace.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+static const unsigned PACK_LANES = 8;
+static const unsigned MAX_TRACE_FLOOR = 15;  // Widest floor the 4-bit field holds
+static const size_t DECODE_AHEAD = 4;         // Decoded blocks the decoder thread may run ahead
+static const char BLOCK_MAGIC[8] = {'E', 'L', 'V', 'B', 'L', 'K', '1', '\0'};
+
+struct block_file_header_t {
+    char magic[8];
+    uint32_t block_records;
+    uint32_t reserved;
+};
+
+struct block_header_t {
+    uint32_t records;
+    uint8_t delta_bits;
+    uint8_t field_bits;
+    uint16_t reserved;
+};
+
+// Index entry: where a block is, what it covers, and the replay state entering it
+struct block_index_t {
+    uint64_t first_cycle;
+    uint64_t last_cycle;
+    uint64_t offset;
+    uint32_t bytes;
+    uint32_t records;
+    uint64_t resume_cycle;       // trace_replay_t::cycle before the block's first record
+    controller_state_t entry;    // Controller state before the block's first record
+    uint8_t reserved[3];
+};
+
+struct block_footer_t {
+    uint64_t index_offset;
+    uint64_t blocks;
+    uint64_t records;
+    char magic[8];
+};
+
+static inline double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static unsigned bits_needed(uint32_t v) {
+    unsigned b = 0;
+    while (b < 32 && (v >> b) != 0) b++;
+    return b;
+}
+
+// Words for n values of width b: whole groups of eight, plus one zero row so
+// decoders can always read the row after the current one
+static size_t packed_words(size_t n, unsigned b) {
+    size_t groups = (n + PACK_LANES - 1) / PACK_LANES;
+    return ((groups * b + 31) / 32 + 1) * PACK_LANES;
+}
+
+static void pack_values(const uint32_t *values, size_t n, unsigned b, uint32_t *words) {
+    memset(words, 0, packed_words(n, b) * sizeof(uint32_t));
+    if (b == 0) return;
+    for (size_t i = 0; i < n; i++) {
+        size_t offset = (i / PACK_LANES) * b;
+        size_t lane = i % PACK_LANES;
+        uint64_t v = (uint64_t)values[i] << (offset & 31);
+        words[(offset >> 5) * PACK_LANES + lane] |= (uint32_t)v;
+        words[((offset >> 5) + 1) * PACK_LANES + lane] |= (uint32_t)(v >> 32);
+    }
+}
+
+// Reference decoder; out must hold n rounded up to a whole group
+static void unpack_scalar(const uint32_t *words, size_t n, unsigned b, uint32_t *out) {
+    const uint32_t mask = b == 32 ? ~0u : (1u << b) - 1;
+    for (size_t g = 0; g * PACK_LANES < n; g++) {
+        size_t offset = g * b;
+        const uint32_t *row = words + (offset >> 5) * PACK_LANES;
+        unsigned shift = offset & 31;
+        for (unsigned lane = 0; lane < PACK_LANES; lane++) {
+            uint64_t pair = row[lane] | (uint64_t)row[lane + PACK_LANES] << 32;
+            out[g * PACK_LANES + lane] = (uint32_t)(pair >> shift) & mask;
+        }
+    }
+}
+
+// Eight values per step with one shift count for all lanes
+static void unpack_simd(const uint32_t *words, size_t n, unsigned b, uint32_t *out) {
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_set1_epi32(b == 32 ? -1 : (int)((1u << b) - 1));
+    for (size_t g = 0; g * PACK_LANES < n; g++) {
+        size_t offset = g * b;
+        const uint32_t *row = words + (offset >> 5) * PACK_LANES;
+        __m128i lo_shift = _mm_cvtsi32_si128((int)(offset & 31));
+        __m128i hi_shift = _mm_cvtsi32_si128(32 - (int)(offset & 31));  // 32 shifts out every bit
+        __m256i lo = _mm256_loadu_si256((const __m256i *)row);
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(row + PACK_LANES));
+        __m256i v = _mm256_or_si256(_mm256_srl_epi32(lo, lo_shift), _mm256_sll_epi32(hi, hi_shift));
+        _mm256_storeu_si256((__m256i *)(out + g * PACK_LANES), _mm256_and_si256(v, mask));
+    }
+#elif defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi32(b == 32 ? -1 : (int)((1u << b) - 1));
+    for (size_t g = 0; g * PACK_LANES < n; g++) {
+        size_t offset = g * b;
+        const uint32_t *row = words + (offset >> 5) * PACK_LANES;
+        __m128i lo_shift = _mm_cvtsi32_si128((int)(offset & 31));
+        __m128i hi_shift = _mm_cvtsi32_si128(32 - (int)(offset & 31));
+        for (unsigned half = 0; half < PACK_LANES; half += 4) {
+            __m128i lo = _mm_loadu_si128((const __m128i *)(row + half));
+            __m128i hi = _mm_loadu_si128((const __m128i *)(row + PACK_LANES + half));
+            __m128i v = _mm_or_si128(_mm_srl_epi32(lo, lo_shift), _mm_sll_epi32(hi, hi_shift));
+            _mm_storeu_si128((__m128i *)(out + g * PACK_LANES + half), _mm_and_si128(v, mask));
+        }
+    }
+#else
+    unpack_scalar(words, n, b, out);
+#endif
+}
+
+static const char *simd_name() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// Decoded block: cycles and packed floor/flag fields, one entry per record
+struct decoded_block_t {
+    vector<uint64_t> cycles;
+    vector<uint32_t> deltas;
+    vector<uint32_t> fields;
+};
+
+template <bool Simd>
+static void decode_block(const uint8_t *data, uint64_t first_cycle, decoded_block_t &out) {
+    block_header_t header;
+    memcpy(&header, data, sizeof(header));
+    const size_t n = header.records;
+    const size_t rounded = (n + PACK_LANES - 1) / PACK_LANES * PACK_LANES;
+    const uint32_t *deltas = (const uint32_t *)(data + sizeof(header));
+    const uint32_t *fields = deltas + packed_words(n, header.delta_bits);
+    out.cycles.resize(n);
+    out.deltas.resize(rounded);
+    out.fields.resize(rounded);
+    if (Simd) {
+        unpack_simd(deltas, n, header.delta_bits, out.deltas.data());
+        unpack_simd(fields, n, header.field_bits, out.fields.data());
+    } else {
+        unpack_scalar(deltas, n, header.delta_bits, out.deltas.data());
+        unpack_scalar(fields, n, header.field_bits, out.fields.data());
+    }
+    uint64_t cycle = first_cycle;
+    for (size_t i = 0; i < n; i++) {
+        cycle += out.deltas[i] + (i != 0);
+        out.cycles[i] = cycle;
+    }
+}
+
+static inline trace_record_t make_record(uint64_t cycle, uint32_t field) {
+    trace_record_t r;
+    memset(&r, 0, sizeof(r));
+    r.cycle = cycle;
+    r.floor = (uint8_t)(field & 15);
+    r.flags = (uint8_t)(field >> 4);
+    return r;
+}
+
+// Sequential reader of a raw trace that checks the header's record count
+// against what the file actually holds
+struct raw_trace_reader_t {
+    FILE *f = nullptr;
+    uint64_t declared = 0;
+    uint64_t read = 0;
+};
+
+static bool open_raw_trace(const char *path, raw_trace_reader_t &reader) {
+    reader.f = fopen(path, "rb");
+    if (!reader.f) return false;
+    trace_header_t header;
+    if (fread(&header, sizeof(header), 1, reader.f) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC))) {
+        fclose(reader.f);
+        reader.f = nullptr;
+        return false;
+    }
+    reader.declared = header.records;
+    reader.read = 0;
+    return true;
+}
+
+// Up to max records; 0 at the end of the file
+static size_t read_raw_records(raw_trace_reader_t &reader, trace_record_t *out, size_t max) {
+    size_t n = fread(out, sizeof(trace_record_t), max, reader.f);
+    reader.read += n;
+    return n;
+}
+
+// Close, reporting whether the file held exactly the records its header declares
+static bool close_raw_trace(raw_trace_reader_t &reader) {
+    bool complete = reader.read == reader.declared && !ferror(reader.f);
+    fclose(reader.f);
+    reader.f = nullptr;
+    return complete;
+}
+
+struct encode_result_t {
+    vector<block_index_t> index;
+    uint64_t records = 0;
+    uint64_t bytes = 0;  // Size of the block file
+};
+
+// Stream a raw trace into a block file: read up to block_records records,
+// encode and write the block, append its index entry, and finish with the
+// index and footer. Only one block of records is held in memory.
+static bool encode_trace(const char *raw_path, const string &block_path, uint32_t block_records,
+                         encode_result_t &out, string &error) {
+    raw_trace_reader_t reader;
+    if (!open_raw_trace(raw_path, reader)) {
+        error = string("Cannot read a trace from ") + raw_path;
+        return false;
+    }
+    FILE *f = fopen(block_path.c_str(), "wb");
+    if (!f) {
+        close_raw_trace(reader);
+        error = "Cannot write " + block_path;
+        return false;
+    }
+
+    block_file_header_t file_header;
+    memcpy(file_header.magic, BLOCK_MAGIC, sizeof(file_header.magic));
+    file_header.block_records = block_records;
+    file_header.reserved = 0;
+    bool ok = fwrite(&file_header, sizeof(file_header), 1, f) == 1;
+    out.bytes = sizeof(file_header);
+
+    trace_replay_t replay = trace_replay_start();
+    vector<trace_record_t> pending(block_records);
+    vector<uint32_t> deltas, fields, words;
+    size_t held = 0;
+    uint64_t previous_cycle = 0;
+    bool at_end = false;
+    while (ok) {
+        // Top up to a full block; a block cut short by a long gap leaves records behind
+        if (!at_end && held < block_records) {
+            size_t n = read_raw_records(reader, pending.data() + held, block_records - held);
+            for (size_t k = held; ok && k < held + n; k++) {
+                if (out.records + k > 0 && pending[k].cycle <= (k > 0 ? pending[k - 1].cycle : previous_cycle)) {
+                    error = "Record " + to_string(out.records + k) + ": cycles must strictly increase";
+                    ok = false;
+                } else if (pending[k].floor > MAX_TRACE_FLOOR) {
+                    error = "Record " + to_string(out.records + k) + ": floor " + to_string(pending[k].floor) +
+                            " does not fit the 4-bit field";
+                    ok = false;
+                }
+            }
+            held += n;
+            at_end = n == 0;
+        }
+        if (!ok || held == 0) break;
+
+        block_index_t entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.first_cycle = pending[0].cycle;
+        entry.offset = out.bytes;
+        entry.resume_cycle = replay.cycle;
+        entry.entry = replay.s;
+
+        // A block ends at block_records, or early at a gap too long for 32 bits
+        deltas.assign(1, 0);
+        fields.assign(1, pending[0].floor | (uint32_t)pending[0].flags << 4);
+        size_t j = 1;
+        for (; j < held; j++) {
+            uint64_t gap = pending[j].cycle - pending[j - 1].cycle - 1;
+            if (gap > 0xFFFFFFFFull) break;
+            deltas.push_back((uint32_t)gap);
+            fields.push_back(pending[j].floor | (uint32_t)pending[j].flags << 4);
+        }
+        for (size_t k = 0; k < j; k++) trace_replay(replay, pending[k]);
+
+        block_header_t header = {(uint32_t)deltas.size(), 0, 0, 0};
+        for (uint32_t d : deltas) header.delta_bits = max<uint8_t>(header.delta_bits, bits_needed(d));
+        for (uint32_t v : fields) header.field_bits = max<uint8_t>(header.field_bits, bits_needed(v));
+        ok = fwrite(&header, sizeof(header), 1, f) == 1;
+        words.resize(packed_words(deltas.size(), header.delta_bits));
+        pack_values(deltas.data(), deltas.size(), header.delta_bits, words.data());
+        ok = ok && fwrite(words.data(), sizeof(uint32_t), words.size(), f) == words.size();
+        size_t delta_words = words.size();
+        words.resize(packed_words(fields.size(), header.field_bits));
+        pack_values(fields.data(), fields.size(), header.field_bits, words.data());
+        ok = ok && fwrite(words.data(), sizeof(uint32_t), words.size(), f) == words.size();
+
+        entry.last_cycle = pending[j - 1].cycle;
+        entry.records = (uint32_t)j;
+        entry.bytes = (uint32_t)(sizeof(header) + (delta_words + words.size()) * sizeof(uint32_t));
+        out.bytes += entry.bytes;
+        out.index.push_back(entry);
+        out.records += j;
+        previous_cycle = entry.last_cycle;
+        move(pending.begin() + j, pending.begin() + held, pending.begin());
+        held -= j;
+    }
+
+    block_footer_t footer = {out.bytes, out.index.size(), out.records, {0}};
+    memcpy(footer.magic, BLOCK_MAGIC, sizeof(footer.magic));
+    ok = ok && fwrite(out.index.data(), sizeof(block_index_t), out.index.size(), f) == out.index.size() &&
+         fwrite(&footer, sizeof(footer), 1, f) == 1;
+    out.bytes += out.index.size() * sizeof(block_index_t) + sizeof(footer);
+    ok = (fclose(f) == 0) && ok;
+    if (!close_raw_trace(reader) && error.empty()) {
+        error = string(raw_path) + ": header declares " + to_string(reader.declared) + " records, file holds " +
+                to_string(reader.read);
+        ok = false;
+    }
+    if (!ok && error.empty()) error = "Cannot write " + block_path;
+    return ok;
+}
+
+// Index and footer of a block file
+static bool read_block_index(FILE *f, vector<block_index_t> &index) {
+    block_footer_t footer;
+    bool ok = fseek(f, -(long)sizeof(footer), SEEK_END) == 0 && fread(&footer, sizeof(footer), 1, f) == 1 &&
+              memcmp(footer.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) == 0;
+    index.resize(ok ? footer.blocks : 0);
+    return ok && fseek(f, (long)footer.index_offset, SEEK_SET) == 0 &&
+           fread(index.data(), sizeof(block_index_t), index.size(), f) == index.size();
+}
+
+static bool read_block(FILE *f, const block_index_t &e, vector<uint8_t> &buffer) {
+    buffer.resize(e.bytes);
+    return fseek(f, (long)e.offset, SEEK_SET) == 0 && fread(buffer.data(), 1, e.bytes, f) == e.bytes;
+}
+
+struct range_result_t {
+    uint64_t records = 0;
+    uint64_t checksum = 0;  // Folds the controller floor after every record in range
+    uint64_t blocks_read = 0;
+};
+
+// Replay the records with from <= cycle <= to, reading only the blocks that overlap
+static bool replay_range(const string &path, uint64_t from, uint64_t to, range_result_t &result) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    vector<block_index_t> index;
+    bool ok = read_block_index(f, index);
+
+    auto first = lower_bound(index.begin(), index.end(), from,
+                             [](const block_index_t &e, uint64_t cycle) { return e.last_cycle < cycle; });
+    vector<uint8_t> buffer;
+    decoded_block_t block;
+    for (auto e = first; ok && e != index.end() && e->first_cycle <= to; ++e) {
+        ok = read_block(f, *e, buffer);
+        if (!ok) break;
+        decode_block<true>(buffer.data(), e->first_cycle, block);
+        result.blocks_read++;
+
+        // Resume from the checkpoint, replaying any records of the block before the range
+        trace_replay_t replay = {e->entry, e->resume_cycle, 0, 0, 0};
+        for (size_t i = 0; i < e->records && block.cycles[i] <= to; i++) {
+            trace_replay(replay, make_record(block.cycles[i], block.fields[i]));
+            if (block.cycles[i] >= from) {
+                result.records++;
+                result.checksum = result.checksum * 31 + replay.s.floor;
+            }
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+// Decode every block of the file; only the decoding itself is timed
+template <bool Simd>
+static bool time_decode(const string &path, const vector<block_index_t> &index, double &seconds, uint64_t &sink) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    vector<uint8_t> buffer;
+    decoded_block_t block;
+    bool ok = true;
+    seconds = 0;
+    for (const auto &e : index) {
+        if (!(ok = read_block(f, e, buffer))) break;
+        auto t = chrono::steady_clock::now();
+        decode_block<Simd>(buffer.data(), e.first_cycle, block);
+        seconds += seconds_since(t);
+        sink += block.cycles.back() + block.fields[0];
+    }
+    fclose(f);
+    return ok;
+}
+
+// End to end from the raw file: read records in chunks and replay them
+static bool replay_raw_file(const char *path, trace_replay_t &replay) {
+    raw_trace_reader_t reader;
+    if (!open_raw_trace(path, reader)) return false;
+    static trace_record_t chunk[4096];
+    replay = trace_replay_start();
+    for (size_t n; (n = read_raw_records(reader, chunk, 4096)) != 0;) {
+        for (size_t i = 0; i < n; i++) trace_replay(replay, chunk[i]);
+    }
+    return close_raw_trace(reader);
+}
+
+// Decoder thread reading and decoding every block of a file into a ring
+// of decoded blocks ahead of the consumer
+class BlockDecoder {
+public:
+    BlockDecoder(FILE *f, const vector<block_index_t> &index) : f_(f), index_(index), ring_(DECODE_AHEAD) {
+        thread_ = thread(&BlockDecoder::run, this);
+    }
+
+    ~BlockDecoder() {
+        {
+            lock_guard<mutex> guard(lock_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+    }
+
+    // Oldest decoded block, nullptr once every block is consumed (or a read failed)
+    const decoded_block_t *acquire() {
+        unique_lock<mutex> guard(lock_);
+        changed_.wait(guard, [&] { return filled_ > 0 || finished_; });
+        return filled_ > 0 ? &ring_[head_] : nullptr;
+    }
+
+    // Hand the block from the last acquire back to the decoder
+    void release() {
+        {
+            lock_guard<mutex> guard(lock_);
+            head_ = (head_ + 1) % ring_.size();
+            filled_--;
+        }
+        changed_.notify_all();
+    }
+
+    bool failed() const { return failed_; }
+
+private:
+    void run() {
+        vector<uint8_t> buffer;
+        size_t tail = 0;
+        for (size_t b = 0; b < index_.size(); b++) {
+            {
+                unique_lock<mutex> guard(lock_);
+                changed_.wait(guard, [&] { return filled_ < ring_.size() || stop_; });
+                if (stop_) return;
+            }
+            // The slot is the decoder's until it is published below
+            bool ok = read_block(f_, index_[b], buffer);
+            if (ok) decode_block<true>(buffer.data(), index_[b].first_cycle, ring_[tail]);
+            {
+                lock_guard<mutex> guard(lock_);
+                if (!ok) {
+                    failed_ = finished_ = true;
+                } else {
+                    filled_++;
+                }
+            }
+            changed_.notify_all();
+            if (!ok) return;
+            tail = (tail + 1) % ring_.size();
+        }
+        {
+            lock_guard<mutex> guard(lock_);
+            finished_ = true;
+        }
+        changed_.notify_all();
+    }
+
+    FILE *f_;
+    const vector<block_index_t> &index_;
+    vector<decoded_block_t> ring_;
+    size_t head_ = 0;
+    size_t filled_ = 0;
+    bool finished_ = false;
+    bool stop_ = false;
+    bool failed_ = false;
+    mutex lock_;
+    condition_variable changed_;
+    thread thread_;
+};
+
+// End to end from the block file: the decoder thread reads and decodes,
+// this thread only replays decoded records
+static bool replay_block_file(const string &path, trace_replay_t &replay) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    vector<block_index_t> index;
+    bool ok = read_block_index(f, index);
+    replay = trace_replay_start();
+    size_t consumed = 0;
+    if (ok) {
+        BlockDecoder decoder(f, index);
+        for (const decoded_block_t *block; (block = decoder.acquire()) != nullptr; consumed++) {
+            for (size_t i = 0; i < block->cycles.size(); i++) {
+                trace_replay(replay, make_record(block->cycles[i], block->fields[i]));
+            }
+            decoder.release();
+        }
+        ok = !decoder.failed() && consumed == index.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+// Compare every decoded record with the raw file, block by block
+static bool check_round_trip(const char *raw_path, const string &block_path, const vector<block_index_t> &index) {
+    raw_trace_reader_t reader;
+    FILE *f = fopen(block_path.c_str(), "rb");
+    if (!f || !open_raw_trace(raw_path, reader)) {
+        if (f) fclose(f);
+        return false;
+    }
+    vector<uint8_t> buffer;
+    vector<trace_record_t> records;
+    decoded_block_t block;
+    bool same = true;
+    for (size_t b = 0; same && b < index.size(); b++) {
+        records.resize(index[b].records);
+        same = read_block(f, index[b], buffer) &&
+               read_raw_records(reader, records.data(), records.size()) == records.size();
+        if (!same) break;
+        decode_block<true>(buffer.data(), index[b].first_cycle, block);
+        for (size_t i = 0; i < records.size(); i++) {
+            same &= block.cycles[i] == records[i].cycle && (block.fields[i] & 15) == records[i].floor &&
+                    (block.fields[i] >> 4) == records[i].flags;
+        }
+    }
+    fclose(f);
+    return close_raw_trace(reader) && same;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "Usage: elevator_trace_codec trace_path [--generate records] [--block 4096] [--from cycle] [--to cycle]"
+             << endl;
+        return 1;
+    }
+    const char *path = argv[1];
+    uint64_t generate = 0, from = 0, to = 0;
+    uint32_t block_records = 4096;
+    int repeats = 5;
+    bool have_range = false;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--generate") && i + 1 < argc) generate = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--block") && i + 1 < argc) block_records = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--from") && i + 1 < argc) { from = strtoull(argv[++i], nullptr, 10); have_range = true; }
+        else if (!strcmp(argv[i], "--to") && i + 1 < argc) { to = strtoull(argv[++i], nullptr, 10); have_range = true; }
+        else if (!strcmp(argv[i], "--repeats") && i + 1 < argc) repeats = atoi(argv[++i]);
+    }
+    if (repeats < 1) {
+        cerr << "repeats must be positive" << endl;
+        return 1;
+    }
+    if (block_records < PACK_LANES) {
+        cerr << "block must hold at least " << PACK_LANES << " records" << endl;
+        return 1;
+    }
+    if (generate && !write_synthetic_trace(path, generate)) {
+        cerr << "Cannot write " << path << endl;
+        return 1;
+    }
+
+    cout << "=== Block-Compressed Trace ===" << endl;
+    const string block_path = string(path) + ".blk";
+    encode_result_t compressed;
+    string error;
+    auto t = chrono::steady_clock::now();
+    if (!encode_trace(path, block_path, block_records, compressed, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+    double encode_seconds = seconds_since(t);
+    if (compressed.records == 0) {
+        cerr << path << " holds no records" << endl;
+        return 1;
+    }
+
+    const double raw_bytes = sizeof(trace_header_t) + compressed.records * sizeof(trace_record_t);
+    cout << compressed.records << " records in " << compressed.index.size() << " blocks of up to " << block_records
+         << ", written to " << block_path << endl;
+    cout << fixed << setprecision(2) << "Raw " << raw_bytes / 1048576 << " MB, compressed "
+         << compressed.bytes / 1048576.0 << " MB (" << raw_bytes / compressed.bytes << "x, "
+         << compressed.bytes * 8.0 / compressed.records << " bits/record), encoded in " << encode_seconds << " s"
+         << endl;
+
+    uint64_t sink = 0;
+    double decode_seconds[2] = {0, 0};
+    bool decoded_ok = time_decode<false>(block_path, compressed.index, decode_seconds[0], sink) &&
+                      time_decode<true>(block_path, compressed.index, decode_seconds[1], sink);
+    bool round_trip = decoded_ok && check_round_trip(path, block_path, compressed.index);
+
+    // End to end, each from its file: one untimed pass of each, then raw and
+    // block replays alternate, starting with each in turn, and medians are compared
+    trace_replay_t raw, decoded;
+    bool raw_ok = replay_raw_file(path, raw);
+    bool blocks_ok = replay_block_file(block_path, decoded);
+    vector<double> raw_times, block_times;
+    for (int r = 0; r < repeats; r++) {
+        for (int k = 0; k < 2; k++) {
+            t = chrono::steady_clock::now();
+            if ((r + k) % 2 == 0) {
+                raw_ok = replay_raw_file(path, raw) && raw_ok;
+                raw_times.push_back(seconds_since(t));
+            } else {
+                blocks_ok = replay_block_file(block_path, decoded) && blocks_ok;
+                block_times.push_back(seconds_since(t));
+            }
+        }
+    }
+    sort(raw_times.begin(), raw_times.end());
+    sort(block_times.begin(), block_times.end());
+    double raw_replay_seconds = raw_times[raw_times.size() / 2];
+    double decoded_replay_seconds = block_times[block_times.size() / 2];
+    double noise = (raw_times.back() - raw_times.front()) / raw_replay_seconds;
+
+    const double n = (double)compressed.records;
+    cout << "\n" << left << setw(28) << "Pass" << right << setw(12) << "Mrecords/s" << setw(18) << "Raw-equiv. GB/s"
+         << endl;
+    cout << string(58, '-') << endl;
+    auto row = [&](const string &label, double seconds) {
+        cout << left << setw(28) << label << right << setw(12) << n / seconds / 1e6 << setw(18)
+             << raw_bytes / seconds / 1e9 << endl;
+    };
+    row("decode only (scalar)", decode_seconds[0]);
+    row(string("decode only (") + simd_name() + ")", decode_seconds[1]);
+    row("read + replay raw file", raw_replay_seconds);
+    row("read + decode + replay", decoded_replay_seconds);
+    double change = raw_replay_seconds / decoded_replay_seconds - 1;
+    cout << "Replaying from the block file is " << setprecision(1) << fabs(100 * change) << "% "
+         << (change < 0 ? "slower" : "faster") << " end to end than from the raw file, median of " << repeats
+         << "; raw repeats spread " << 100 * noise << "%: " << (fabs(change) <= noise ? "within noise" : "OUTSIDE noise")
+         << " (checksum " << sink % 1000 << ")" << endl;
+    if (thread::hardware_concurrency() < 2) {
+        cout << "Single core: the decoder thread shares it with the replay, so decoding is not hidden" << endl;
+    }
+
+    bool same = raw_ok && blocks_ok && decoded.checksum == raw.checksum && decoded.accepted == raw.accepted;
+    cout << "Round trip exact: " << (round_trip ? "yes" : "NO") << ", replays match: " << (same ? "yes" : "NO")
+         << endl;
+
+    // Time-range query: by default the middle 1% of the trace's blocks
+    if (!have_range || to < from) {
+        const block_index_t &middle = compressed.index[compressed.index.size() / 2];
+        from = middle.first_cycle;
+        to = compressed.index[min(compressed.index.size() - 1, compressed.index.size() / 2 +
+                                  compressed.index.size() / 100)].last_cycle;
+    }
+    range_result_t range;
+    t = chrono::steady_clock::now();
+    bool range_ok = replay_range(block_path, from, to, range);
+    double range_seconds = seconds_since(t);
+
+    // Same records from a full replay of the raw file, for comparison
+    raw_trace_reader_t reader;
+    trace_replay_t full = trace_replay_start();
+    uint64_t expected_records = 0, expected_checksum = 0;
+    bool full_ok = open_raw_trace(path, reader);
+    static trace_record_t chunk[4096];
+    bool past = false;
+    for (size_t count; full_ok && !past && (count = read_raw_records(reader, chunk, 4096)) != 0;) {
+        for (size_t i = 0; i < count && !(past = chunk[i].cycle > to); i++) {
+            trace_replay(full, chunk[i]);
+            if (chunk[i].cycle >= from) {
+                expected_records++;
+                expected_checksum = expected_checksum * 31 + full.s.floor;
+            }
+        }
+    }
+    if (full_ok) close_raw_trace(reader);
+    bool range_same = range_ok && full_ok && range.records == expected_records && range.checksum == expected_checksum;
+    cout << "\nCycles " << from << "-" << to << ": " << range.records << " records from " << range.blocks_read
+         << " of " << compressed.index.size() << " blocks in " << setprecision(2) << range_seconds * 1e3
+         << " ms, matches full replay: " << (range_same ? "yes" : "NO") << endl;
+
+    return round_trip && same && range_same ? 0 : 1;
+}
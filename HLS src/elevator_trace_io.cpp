@@ -0,0 +1,334 @@
+// Trace replay with reads overlapped with simulation
+// (host-side tool, not part of synthesis).
+//
+// A reader thread prefetches the trace in fixed-size chunks into a ring of
+// page-aligned buffers while the main thread replays the oldest filled
+// chunk through controller_transition (see elevator_trace.h). The reader
+// only blocks when every buffer is full and the replay only when every
+// buffer is empty, so throughput approaches the slower of disk and
+// simulation instead of their sum. The report compares:
+//   serial      - read a chunk, replay it, read the next (one buffer)
+//   read-only   - the prefetching reader alone (disk rate)
+//   overlapped  - prefetching reader and replay together
+// The file's page cache is dropped before each run, so reads come from the
+// device; --direct opens it with O_DIRECT instead (where supported).
+//
+// Build: g++ -O2 -std=c++14 -pthread -I$XILINX_HLS/include elevator_hls.cpp elevator_trace_io.cpp -o elevator_trace_io
+// Usage: elevator_trace_io trace_path [--generate records] [--chunk-kb 1024] [--buffers 4] [--direct]
+
+#include "elevator_trace.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const size_t IO_ALIGN = 4096;  // Buffer, chunk and offset alignment O_DIRECT needs
+
+struct trace_buffer_t {
+    uint8_t *data;
+    size_t bytes;  // Filled bytes, 0 at end of file
+};
+
+static inline double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Read until the buffer is full or the file ends; -1 on error
+static ssize_t read_full(int fd, uint8_t *buffer, size_t length) {
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = read(fd, buffer + done, length - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) break;
+        done += (size_t)n;
+    }
+    return (ssize_t)done;
+}
+
+static int open_trace(const char *path, bool direct) {
+    if (direct) {
+        int fd = open(path, O_RDONLY | O_DIRECT);
+        if (fd >= 0) return fd;
+        cerr << "O_DIRECT not supported here, using buffered reads" << endl;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        // Drop cached pages so the run reads from the device
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    return fd;
+}
+
+// Reader thread filling a ring of aligned buffers ahead of the consumer
+class PrefetchReader {
+public:
+    PrefetchReader(int fd, size_t chunk_bytes, int buffers) : fd_(fd), ring_(buffers) {
+        for (auto &b : ring_) {
+            void *p = nullptr;
+            if (posix_memalign(&p, IO_ALIGN, chunk_bytes) != 0) throw bad_alloc();
+            b.data = (uint8_t *)p;
+            b.bytes = chunk_bytes;  // Capacity until filled
+        }
+        thread_ = thread(&PrefetchReader::run, this);
+    }
+
+    ~PrefetchReader() {
+        {
+            lock_guard<mutex> guard(lock_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+        for (auto &b : ring_) free(b.data);
+    }
+
+    // Oldest filled buffer, nullptr once the file is exhausted (or a read failed)
+    const trace_buffer_t *acquire() {
+        unique_lock<mutex> guard(lock_);
+        changed_.wait(guard, [&] { return filled_ > 0 || finished_; });
+        if (filled_ == 0) return nullptr;
+        const trace_buffer_t *b = &ring_[head_];
+        return b->bytes ? b : nullptr;
+    }
+
+    // Hand the buffer from the last acquire back to the reader
+    void release() {
+        {
+            lock_guard<mutex> guard(lock_);
+            head_ = (head_ + 1) % ring_.size();
+            filled_--;
+        }
+        changed_.notify_all();
+    }
+
+    bool failed() const { return failed_; }
+
+private:
+    void run() {
+        size_t tail = 0;
+        const size_t capacity = ring_[0].bytes;
+        for (;;) {
+            {
+                unique_lock<mutex> guard(lock_);
+                changed_.wait(guard, [&] { return filled_ < ring_.size() || stop_; });
+                if (stop_) return;
+            }
+            // The slot is the reader's until it is published below
+            ssize_t n = read_full(fd_, ring_[tail].data, capacity);
+            {
+                lock_guard<mutex> guard(lock_);
+                failed_ = n < 0;
+                ring_[tail].bytes = n > 0 ? (size_t)n : 0;
+                filled_++;
+                finished_ = n <= 0;
+            }
+            changed_.notify_all();
+            if (n <= 0) return;
+            tail = (tail + 1) % ring_.size();
+        }
+    }
+
+    int fd_;
+    vector<trace_buffer_t> ring_;
+    size_t head_ = 0;
+    size_t filled_ = 0;
+    bool finished_ = false;
+    bool stop_ = false;
+    bool failed_ = false;
+    mutex lock_;
+    condition_variable changed_;
+    thread thread_;
+};
+
+// Replays whole records from successive chunks; the first chunk starts with the header
+class ChunkReplayer {
+public:
+    bool replay(const uint8_t *data, size_t bytes, bool simulate) {
+        if (first_) {
+            first_ = false;
+            trace_header_t header;
+            if (bytes < sizeof(header)) return false;
+            memcpy(&header, data, sizeof(header));
+            if (memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) return false;
+            expected = header.records;
+            data += sizeof(header);
+            bytes -= sizeof(header);
+        }
+        // Chunks are multiples of the record size, so records never straddle two
+        size_t n = bytes / sizeof(trace_record_t);
+        const trace_record_t *records = (const trace_record_t *)data;
+        if (simulate) {
+            for (size_t i = 0; i < n; i++) trace_replay(state, records[i]);
+        } else {
+            state.records += n;
+        }
+        return true;
+    }
+
+    trace_replay_t state = trace_replay_start();
+    uint64_t expected = 0;
+
+private:
+    bool first_ = true;
+};
+
+struct run_result_t {
+    double seconds = 0;
+    double read_seconds = 0;    // Serial run only
+    double replay_seconds = 0;  // Serial run only
+    trace_replay_t state;
+    bool ok = false;
+};
+
+static run_result_t run_serial(const char *path, size_t chunk_bytes, bool direct) {
+    run_result_t result;
+    int fd = open_trace(path, direct);
+    if (fd < 0) return result;
+    void *p = nullptr;
+    if (posix_memalign(&p, IO_ALIGN, chunk_bytes) != 0) {
+        close(fd);
+        return result;
+    }
+    uint8_t *buffer = (uint8_t *)p;
+
+    ChunkReplayer replayer;
+    bool ok = true;
+    auto start = chrono::steady_clock::now();
+    for (;;) {
+        auto t = chrono::steady_clock::now();
+        ssize_t n = read_full(fd, buffer, chunk_bytes);
+        result.read_seconds += seconds_since(t);
+        if (n <= 0) {
+            ok = n == 0;
+            break;
+        }
+        t = chrono::steady_clock::now();
+        ok = replayer.replay(buffer, (size_t)n, true);
+        result.replay_seconds += seconds_since(t);
+        if (!ok) break;
+    }
+    result.seconds = seconds_since(start);
+    result.state = replayer.state;
+    result.ok = ok && replayer.state.records == replayer.expected;
+    free(buffer);
+    close(fd);
+    return result;
+}
+
+static run_result_t run_prefetched(const char *path, size_t chunk_bytes, int buffers, bool direct, bool simulate) {
+    run_result_t result;
+    int fd = open_trace(path, direct);
+    if (fd < 0) return result;
+
+    ChunkReplayer replayer;
+    bool ok = true, failed;
+    auto start = chrono::steady_clock::now();
+    {
+        PrefetchReader reader(fd, chunk_bytes, buffers);
+        while (const trace_buffer_t *b = reader.acquire()) {
+            ok = replayer.replay(b->data, b->bytes, simulate);
+            reader.release();
+            if (!ok) break;
+        }
+        failed = reader.failed();
+    }
+    result.seconds = seconds_since(start);
+    result.state = replayer.state;
+    result.ok = ok && !failed && replayer.state.records == replayer.expected;
+    close(fd);
+    return result;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "Usage: elevator_trace_io trace_path [--generate records] [--chunk-kb 1024] [--buffers 4] [--direct]"
+             << endl;
+        return 1;
+    }
+    const char *path = argv[1];
+    uint64_t generate = 0;
+    size_t chunk_kb = 1024;
+    int buffers = 4;
+    bool direct = false;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--generate") && i + 1 < argc) generate = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--chunk-kb") && i + 1 < argc) chunk_kb = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--buffers") && i + 1 < argc) buffers = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--direct")) direct = true;
+    }
+    if (chunk_kb < 4 || chunk_kb % 4 != 0 || buffers < 2) {
+        cerr << "chunk-kb must be a positive multiple of 4 and buffers at least 2" << endl;
+        return 1;
+    }
+    const size_t chunk_bytes = chunk_kb * 1024;
+
+    if (generate) {
+        cout << "Writing " << generate << " records to " << path << endl;
+        if (!write_synthetic_trace(path, generate)) {
+            cerr << "Cannot write " << path << endl;
+            return 1;
+        }
+    }
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        cerr << "Cannot open " << path << endl;
+        return 1;
+    }
+    // Flush a freshly written trace so dropping its cache really drops it
+    int sync_fd = open(path, O_RDONLY);
+    if (sync_fd >= 0) {
+        fdatasync(sync_fd);
+        close(sync_fd);
+    }
+
+    cout << "=== Overlapped Trace Replay ===" << endl;
+    cout << "Trace: " << path << " (" << st.st_size / (1024 * 1024) << " MB), chunk " << chunk_kb << " KB, "
+         << buffers << " buffers" << (direct ? ", O_DIRECT" : "") << endl;
+
+    run_result_t serial = run_serial(path, chunk_bytes, direct);
+    run_result_t read_only = run_prefetched(path, chunk_bytes, buffers, direct, false);
+    run_result_t overlapped = run_prefetched(path, chunk_bytes, buffers, direct, true);
+    if (!serial.ok || !read_only.ok || !overlapped.ok) {
+        cerr << "Trace is unreadable, truncated, or not a trace file" << endl;
+        return 1;
+    }
+
+    const double mb = st.st_size / (1024.0 * 1024.0);
+    const double records = (double)serial.state.records;
+    cout << "\n" << left << setw(22) << "Run" << right << setw(10) << "Seconds" << setw(10) << "MB/s"
+         << setw(14) << "Mrecords/s" << endl;
+    cout << string(56, '-') << endl;
+    auto row = [&](const char *label, double seconds) {
+        cout << left << setw(22) << label << right << fixed << setprecision(3) << setw(10) << seconds
+             << setprecision(1) << setw(10) << mb / seconds << setw(14) << records / seconds / 1e6 << endl;
+    };
+    row("serial: reads", serial.read_seconds);
+    row("serial: replay", serial.replay_seconds);
+    row("serial total", serial.seconds);
+    row("read-only", read_only.seconds);
+    row("overlapped", overlapped.seconds);
+
+    double bound = max(read_only.seconds, serial.replay_seconds);
+    cout << "\nOverlapped / slower of disk and replay: " << setprecision(2) << overlapped.seconds / bound
+         << " (serial: " << serial.seconds / bound << ")" << endl;
+    bool same = serial.state.checksum == overlapped.state.checksum && serial.state.accepted == overlapped.state.accepted;
+    cout << "Accepted requests: " << overlapped.state.accepted << ", replays match: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
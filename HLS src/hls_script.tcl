@@ -1,8 +1,12 @@
 # Simple HLS script for minimal elevator controller
 open_project elevator_hls_project
 set_top elevator_controller
-add_files elevator_hls.cpp
-add_files -tb elevator_hls_tb.cpp
+# set_top elevator_dispatch_controller  ;# queued controller with call ages
+# set_top elevator_panel_controller     ;# button-panel bitmap inputs
+# set_top elevator_sla_controller       ;# per-floor deadlines (EDF)
+# set_top elevator_dual_rate_controller ;# motion every cycle, dispatch over a scan
+add_files elevator_hls.cpp -cflags "-std=c++14"
+add_files -tb elevator_hls_tb.cpp -cflags "-std=c++14"
 
 open_solution "solution1"
 set_part {xc7z020-clg400-1}
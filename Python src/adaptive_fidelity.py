@@ -0,0 +1,188 @@
+"""Adaptive-fidelity group simulation for long, mostly quiet runs.
+
+Limitation: the closed form is only used while the whole group is
+quiescent (every car idle, no call waiting). The collective controller
+assigns each call across all cars, so one car's trip is not independent
+of the others and cannot be switched to the closed form per car or per
+busy interval without losing exact agreement with the event model. On
+the office-day profile only the quiet night and early-morning passengers
+qualify: 7-10% of passengers are handled analytically and the measured
+speedup is 1.08-1.09x for 10-25 floors and 2-6 cars (run this module to
+reproduce). Busy periods dominate the run time and are simulated in full.
+"""
+
+from typing import List, Optional, Tuple
+import time
+from traffic_simulation import TrafficGenerator, GroupSimulation, GroupState
+
+# (hours, arrival rate per second, pattern) segments of a typical office day
+OFFICE_DAY = [
+    (7, 0.002, 'interfloor'),
+    (1.5, 0.15, 'up_peak'),
+    (3, 0.03, 'mixed'),
+    (1, 0.08, 'mixed'),
+    (3.5, 0.03, 'mixed'),
+    (1.5, 0.12, 'down_peak'),
+    (6.5, 0.004, 'interfloor')
+]
+
+def day_profile(num_floors: int, segments: List[Tuple[float, float, str]] = OFFICE_DAY,
+                seed: int = 0) -> List[Tuple[float, int, int]]:
+    """Arrivals for a sequence of constant-rate segments, concatenated in time"""
+    arrivals = []
+    offset = 0.0
+    for index, (hours, rate, pattern) in enumerate(segments):
+        generator = TrafficGenerator(num_floors, rate, pattern, seed=f"{seed}:{index}")
+        arrivals.extend((offset + t, origin, destination)
+                        for t, origin, destination in generator.generate(hours * 3600))
+        offset += hours * 3600
+    return arrivals
+
+class AdaptiveFidelitySimulation:
+    """Group simulation that skips the event-level model while the building is quiet.
+
+    Whenever no car is busy, the next passenger's whole trip has a closed
+    form under the collective controller: the first car claims the call
+    (unless a car already stands at the origin, in which case that car
+    boards at once and the first car drifts one floor before standing
+    down), travels, boards, rides and alights. If that trip completes before
+    the next arrival and the run horizon, it is applied analytically;
+    otherwise the passenger is admitted to the full event model, which then
+    runs until the group is quiescent again. With a departure policy, lobby
+    arrivals always go to the event model: the policy observes them and may
+    hold the car that boards them, which the closed form does not model.
+    Because the closed form reproduces the event model's decisions exactly,
+    results match a full-fidelity run up to floating-point rounding;
+    `fidelity_report` measures the actual deviation.
+    """
+
+    def __init__(self, simulation: GroupSimulation):
+        self.simulation = simulation
+
+    def _isolated_trip(self, state: GroupState, arrival: Tuple[float, int, int]) -> dict:
+        """Closed-form outcome of serving one passenger from a quiescent state"""
+        t0, origin, destination = arrival
+        timing = self.simulation.timing
+        first = state.cars[0]
+        drift = 0
+
+        if first.floor == origin:
+            server, wait = first, 0.0
+        else:
+            waiting_car = next((car for car in state.cars if car.floor == origin), None)
+            if waiting_car is not None:
+                server, wait = waiting_car, 0.0
+                drift = 1 if origin > first.floor else -1
+            else:
+                server, wait = first, timing.travel_time(first.floor, origin)
+
+        boarded = t0 + wait
+        arrived = boarded + timing.transfer_time(1) + timing.travel_time(origin, destination)
+        finish = arrived + timing.transfer_time(1)
+        if drift:
+            finish = max(finish, t0 + timing.seconds_per_floor)
+
+        return {'server': server, 'drift': drift, 'wait': wait, 'journey': arrived - t0,
+                'arrival_time': t0, 'destination': destination, 'finish': finish}
+
+    def _apply(self, state: GroupState, trip: dict):
+        state.waits.append(trip['wait'])
+        state.journeys.append(trip['journey'])
+        if state.alighted is not None:
+            state.alighted.append((trip['arrival_time'] + trip['journey'], trip['arrival_time'], trip['destination']))
+        state.stops += 2  # Boarding and alighting stops
+        state.cars[0].floor += trip['drift']
+        trip['server'].floor = trip['destination']
+        state.now = trip['finish']
+
+    def run(self, arrivals, duration: Optional[float] = None) -> dict:
+        """Simulate like GroupSimulation.run, reporting how much was handled analytically"""
+        simulation = self.simulation
+        state = simulation.start(arrivals, duration)
+        end_time = duration if duration is not None else float('inf')
+        analytic = events = 0
+
+        while not state.finished:
+            # No pending car events means every car is idle and no call is waiting
+            if not state.events:
+                arrival_time = state.source.peek_time()
+                if arrival_time == float('inf') or arrival_time > end_time:
+                    state.finished = True
+                    break
+                arrival = state.source.pop()
+                batched = simulation.departure_policy is not None and arrival[1] == simulation.lobby
+                trip = self._isolated_trip(state, arrival)
+                if not batched and trip['finish'] < state.source.peek_time() and trip['finish'] <= end_time:
+                    self._apply(state, trip)
+                    analytic += 1
+                    continue
+                simulation.admit(state, arrival)
+
+            if not simulation.step(state, end_time):
+                break
+            events += 1
+
+        result = simulation.summarise(state)
+        result['analytic_passengers'] = analytic
+        result['events'] = events
+        return result
+
+def fidelity_report(simulation: GroupSimulation, workloads: List[list],
+                    metrics: Tuple[str, ...] = ('mean_wait', 'p95_wait', 'max_wait', 'mean_journey')) -> dict:
+    """Compare adaptive and full-fidelity runs over workloads; errors are worst-case absolute differences"""
+    adaptive = AdaptiveFidelitySimulation(simulation)
+    full_time = adaptive_time = 0.0
+    analytic = passengers = 0
+    errors = {metric: 0.0 for metric in metrics}
+    errors['passenger_wait'] = 0.0
+    count_mismatches = 0
+
+    for arrivals in workloads:
+        start = time.time()
+        reference = simulation.run(arrivals)
+        full_time += time.time() - start
+
+        start = time.time()
+        result = adaptive.run(arrivals)
+        adaptive_time += time.time() - start
+
+        analytic += result['analytic_passengers']
+        passengers += result['passengers_served']
+        for metric in metrics:
+            errors[metric] = max(errors[metric], abs(result[metric] - reference[metric]))
+        if result['passengers_served'] != reference['passengers_served'] or result['stops'] != reference['stops']:
+            count_mismatches += 1
+        else:
+            # Waits are recorded in a different order, so compare them as distributions
+            for a, b in zip(sorted(result['waits']), sorted(reference['waits'])):
+                errors['passenger_wait'] = max(errors['passenger_wait'], abs(a - b))
+
+    return {
+        'workloads': len(workloads),
+        'passengers': passengers,
+        'analytic_fraction': analytic / passengers if passengers else 0.0,
+        'full_time': full_time,
+        'adaptive_time': adaptive_time,
+        'speedup': full_time / adaptive_time if adaptive_time > 0 else float('inf'),
+        'max_abs_error': errors,
+        'count_mismatches': count_mismatches
+    }
+
+def demonstrate_adaptive_fidelity():
+    """Compare adaptive and full-fidelity simulation of office days"""
+    print("=== Adaptive-Fidelity Simulation Demonstration ===\n")
+    print(f"{'Building':<24} {'Analytic':<10} {'Full (s)':<10} {'Adaptive (s)':<14} {'Speedup':<9} "
+          f"{'Max wait error (s)'}")
+    print("-" * 86)
+
+    for num_floors, num_cars in ((10, 2), (16, 4), (25, 6)):
+        simulation = GroupSimulation(num_floors=num_floors, num_cars=num_cars, car_capacity=13)
+        workloads = [day_profile(num_floors, seed=seed) for seed in range(3)]
+        report = fidelity_report(simulation, workloads)
+        worst = max(report['max_abs_error'].values())
+        print(f"{num_floors} floors, {num_cars} cars{'':<9} {report['analytic_fraction']:<10.1%} "
+              f"{report['full_time']:<10.2f} {report['adaptive_time']:<14.2f} {report['speedup']:<9.2f} "
+              f"{worst:.1e}{'' if report['count_mismatches'] == 0 else ' (count mismatch)'}")
+
+if __name__ == "__main__":
+    demonstrate_adaptive_fidelity()
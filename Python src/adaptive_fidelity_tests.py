@@ -0,0 +1,108 @@
+import unittest
+from traffic_simulation import TrafficGenerator, GroupSimulation
+from adaptive_fidelity import AdaptiveFidelitySimulation, day_profile, fidelity_report
+from lobby_batching import LobbyBatchingPolicy, AdaptiveLobbyBatching
+
+class TestAdaptiveFidelity(unittest.TestCase):
+
+    def setUp(self):
+        self.simulation = GroupSimulation(num_floors=10, num_cars=3, car_capacity=10)
+        self.adaptive = AdaptiveFidelitySimulation(self.simulation)
+
+    def _assert_matches(self, arrivals, duration=None):
+        reference = self.simulation.run(arrivals, duration)
+        result = self.adaptive.run(arrivals, duration)
+        self.assertEqual(result['passengers_served'], reference['passengers_served'])
+        self.assertEqual(result['stops'], reference['stops'])
+        for a, b in zip(sorted(result['waits']), sorted(reference['waits'])):
+            self.assertAlmostEqual(a, b, places=9)
+        self.assertAlmostEqual(result['mean_journey'], reference['mean_journey'], places=9)
+        return result
+
+    def test_low_load_is_mostly_analytic(self):
+        """Test sparse traffic is handled almost entirely in closed form"""
+        arrivals = TrafficGenerator(10, 0.003, 'interfloor', seed=1).generate(4 * 3600)
+        result = self._assert_matches(arrivals)
+        self.assertGreater(result['analytic_passengers'], 0.8 * result['passengers_served'])
+
+    def test_busy_traffic_matches_full_fidelity(self):
+        """Test overlapping trips fall back to the event model with identical results"""
+        arrivals = TrafficGenerator(10, 0.2, 'mixed', seed=2).generate(1800)
+        self._assert_matches(arrivals)
+
+    def test_day_profile_matches_full_fidelity(self):
+        """Test a day alternating quiet and peak periods"""
+        self._assert_matches(day_profile(10, seed=3))
+
+    def test_car_waiting_at_origin(self):
+        """Test the closed form when another car already stands at the origin"""
+        # Send car 0 up so it idles at floor 8 while cars 1 and 2 stay at the lobby
+        arrivals = [(0.0, 1, 8), (100.0, 1, 4), (200.0, 8, 2), (300.0, 5, 6)]
+        result = self._assert_matches(arrivals)
+        self.assertEqual(result['analytic_passengers'], 4)
+
+    def test_horizon_is_respected(self):
+        """Test trips running past the horizon are left to the event model"""
+        arrivals = [(0.0, 1, 10), (500.0, 10, 1)]
+        self._assert_matches(arrivals, duration=510)
+
+    def test_fidelity_report(self):
+        """Test the report's error bound and analytic share"""
+        report = fidelity_report(self.simulation, [day_profile(10, seed=seed) for seed in range(2)])
+        self.assertEqual(report['count_mismatches'], 0)
+        self.assertLess(max(report['max_abs_error'].values()), 1e-6)
+        self.assertGreater(report['analytic_fraction'], 0.0)
+
+    def test_fidelity_report_with_departure_policy(self):
+        """Test lobby batching is applied, and the policy's rate estimate kept, in the adaptive run"""
+        for policy in (LobbyBatchingPolicy(0.6, 20.0), AdaptiveLobbyBatching()):
+            simulation = GroupSimulation(num_floors=10, num_cars=3, car_capacity=10, departure_policy=policy)
+            workloads = [TrafficGenerator(10, 0.003, 'up_peak', seed=seed).generate(4 * 3600) for seed in range(2)]
+            workloads.append(day_profile(10, seed=4))
+            report = fidelity_report(simulation, workloads)
+            self.assertEqual(report['count_mismatches'], 0)
+            self.assertLess(max(report['max_abs_error'].values()), 1e-6)
+            self.assertGreater(report['analytic_fraction'], 0.0)
+
+            arrivals = workloads[0]
+            reference = simulation.start(arrivals)
+            while simulation.step(reference):
+                pass
+            adaptive = AdaptiveFidelitySimulation(simulation)
+            start = simulation.start
+            states = []
+            simulation.start = lambda *args: states.append(start(*args)) or states[-1]
+            try:
+                adaptive.run(arrivals)
+            finally:
+                del simulation.start
+            self.assertEqual(states[0].policy_state, reference.policy_state)
+
+    def test_alighted_is_recorded_for_analytic_trips(self):
+        """Test closed-form trips log their alighting like the event model"""
+        arrivals = [(0.0, 1, 8), (100.0, 1, 4), (200.0, 8, 2), (300.0, 5, 6)]
+        reference = self.simulation.start(arrivals)
+        reference.alighted = []
+        while self.simulation.step(reference):
+            pass
+        start = self.simulation.start
+        states = []
+
+        def recording_start(*args):
+            states.append(start(*args))
+            states[-1].alighted = []
+            return states[-1]
+
+        self.simulation.start = recording_start
+        try:
+            result = self.adaptive.run(arrivals)
+        finally:
+            del self.simulation.start
+        self.assertEqual(result['analytic_passengers'], 4)
+        self.assertEqual(len(states[0].alighted), len(reference.alighted))
+        for a, b in zip(sorted(states[0].alighted), sorted(reference.alighted)):
+            for x, y in zip(a, b):
+                self.assertAlmostEqual(x, y, places=9)
+
+if __name__ == "__main__":
+    unittest.main()
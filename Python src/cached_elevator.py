@@ -158,7 +158,8 @@ class ElevatorCache:
         }
 
 class CachedElevator:
-    def __init__(self, num_floors: int = 10, starting_floor: int = 1, enable_caching: bool = True):
+    def __init__(self, num_floors: int = 10, starting_floor: int = 1, enable_caching: bool = True,
+                 parking_schedule=None, car_index: Optional[int] = None):
         self.num_floors = num_floors
         self.current_floor = starting_floor
         self.state = ElevatorState.IDLE
@@ -177,6 +178,10 @@ class CachedElevator:
         self.pre_position_enabled = True
         self.last_request_time = time.time()
         self.idle_threshold = 30  # seconds before considering pre-positioning
+        # Offline-compiled ParkingSchedule; when set it replaces the learned idle position.
+        # car_index picks this car's entry; without it the car joins the zone with the most cars.
+        self.parking_schedule = parking_schedule
+        self.car_index = car_index
 
         # Energy tracking
         self.total_movements = 0
@@ -244,7 +249,10 @@ class CachedElevator:
         if not self._should_pre_position():
             return None
 
-        optimal_floor = self.cache.get_optimal_idle_position()
+        if self.parking_schedule is not None:
+            optimal_floor = self.parking_schedule.parking_floor(self.car_index)
+        else:
+            optimal_floor = self.cache.get_optimal_idle_position()
 
         if optimal_floor != self.current_floor:
             movements_to_optimal = abs(optimal_floor - self.current_floor)
@@ -0,0 +1,365 @@
+from typing import List, Dict, Optional, Tuple
+import heapq
+import multiprocessing
+import random
+import statistics
+import time
+from traffic_simulation import TimingModel, TrafficGenerator, ArrivalStream, GroupSimulation
+
+class BankSpec:
+    """One elevator bank of a campus: its building and the traffic that starts there"""
+
+    def __init__(self, num_floors: int = 10, num_cars: int = 2, car_capacity: int = 10,
+                 arrival_rate: float = 0.1, transfer_rate: float = 0.02, pattern: str = 'mixed'):
+        self.num_floors = num_floors
+        self.num_cars = num_cars
+        self.car_capacity = car_capacity
+        self.arrival_rate = arrival_rate  # Trips within the bank, passengers per second
+        self.transfer_rate = transfer_rate  # Trips to another bank, passengers per second
+        self.pattern = pattern
+
+class Campus:
+    """Elevator banks joined by walkways between their lobbies.
+
+    A transfer passenger rides from an upper floor of one bank down to its
+    lobby, walks to another bank's lobby, and rides up from there. The
+    walk is the only coupling between banks, so the shortest walk is a
+    lower bound on how far ahead of the sender an arrival is scheduled:
+    the lookahead of a conservative parallel simulation.
+    """
+
+    def __init__(self, banks: List[BankSpec], walk_times: Optional[List[List[float]]] = None,
+                 timing: Optional[TimingModel] = None, seed: int = 0):
+        if len(banks) < 2:
+            raise ValueError("a campus needs at least two banks")
+        self.banks = banks
+        # Default: banks in a row, 60s between neighbours plus 20s per further bank
+        self.walk_times = walk_times or [[0.0 if a == b else 40.0 + 20.0 * abs(a - b) for b in range(len(banks))]
+                                         for a in range(len(banks))]
+        self.timing = timing or TimingModel()
+        self.seed = seed
+        if self.lookahead() <= 0:
+            raise ValueError("walk times between banks must be positive")
+
+    def lookahead(self) -> float:
+        return min(self.walk_times[a][b] for a in range(len(self.banks)) for b in range(len(self.banks)) if a != b)
+
+    def simulation(self, bank: int) -> GroupSimulation:
+        spec = self.banks[bank]
+        return GroupSimulation(spec.num_floors, spec.num_cars, spec.car_capacity, self.timing)
+
+    def generate(self, bank: int, duration: float) -> Tuple[list, Dict[tuple, list]]:
+        """Arrivals starting in one bank, and the onward walk of each transfer passenger.
+
+        Continuations are keyed by (arrival_time, lobby) of the first leg and
+        hold (target_bank, destination, walk_time, trip_start). Each bank
+        draws from its own seed, so a bank's traffic is the same whichever
+        process generates it.
+        """
+        spec = self.banks[bank]
+        seed = self.seed * 1000003 + bank
+        arrivals = TrafficGenerator(spec.num_floors, spec.arrival_rate, spec.pattern, seed=seed).generate(duration)
+        continuations = {}
+        rng = random.Random(f"{seed}:transfers")
+        t = 0.0
+        while spec.transfer_rate > 0:
+            t += rng.expovariate(spec.transfer_rate)
+            if t >= duration:
+                break
+            origin = rng.randint(2, spec.num_floors)
+            target = rng.choice([b for b in range(len(self.banks)) if b != bank])
+            destination = rng.randint(2, self.banks[target].num_floors)
+            arrivals.append((t, origin, 1))
+            continuations.setdefault((t, 1), []).append((target, destination, self.walk_times[bank][target], t))
+        arrivals.sort()
+        return arrivals, continuations
+
+class TransferArrivals(ArrivalStream):
+    """Replayed arrivals merged with transfer passengers injected while the run is in progress"""
+
+    def __init__(self, arrivals: List[Tuple[float, int, int]]):
+        super().__init__(arrivals=arrivals)
+        self.injected = []  # (time, sequence, origin, destination)
+        self.injections = 0
+
+    def inject(self, arrival: Tuple[float, int, int]):
+        heapq.heappush(self.injected, (arrival[0], self.injections, arrival[1], arrival[2]))
+        self.injections += 1
+
+    def peek_time(self) -> float:
+        replayed = super().peek_time()
+        return min(replayed, self.injected[0][0]) if self.injected else replayed
+
+    def pop(self) -> Tuple[float, int, int]:
+        # Replayed arrivals go first on a tie, injections in the order they were delivered
+        if self.injected and self.injected[0][0] < super().peek_time():
+            t, _, origin, destination = heapq.heappop(self.injected)
+            return t, origin, destination
+        return super().pop()
+
+class BankRunner:
+    """One bank's resumable simulation plus the bookkeeping for its transfer passengers"""
+
+    def __init__(self, campus: Campus, bank: int, duration: float):
+        self.bank = bank
+        self.simulation = campus.simulation(bank)
+        arrivals, self.continuations = campus.generate(bank, duration)
+        self.source = TransferArrivals(arrivals)
+        self.state = self.simulation.start(self.source)
+        self.state.alighted = []
+        self.trip_starts = {}  # (arrival_time, destination) of an injected second leg -> trip start
+        self.transfer_journeys = []
+        self.sent = 0
+        self.events = 0
+
+    def next_time(self) -> float:
+        event_time = self.state.events[0][0] if self.state.events else float('inf')
+        return min(self.source.peek_time(), event_time)
+
+    def deliver(self, message: tuple):
+        t, _, _, _, destination, trip_start = message
+        self.source.inject((t, self.simulation.lobby, destination))
+        self.trip_starts.setdefault((t, destination), []).append(trip_start)
+
+    def step(self):
+        self.simulation.step(self.state)
+        self.events += 1
+
+    def run_before(self, until: float):
+        """Process every event strictly earlier than `until`"""
+        while self.next_time() < until:
+            self.step()
+
+    def drain(self) -> List[tuple]:
+        """Messages for passengers who finished a leg since the last drain.
+
+        A message is (arrival_time, source_bank, sequence, target_bank,
+        destination, trip_start); the first three fields order messages the
+        same way however the banks are partitioned.
+        """
+        messages = []
+        for now, arrived, floor in self.state.alighted:
+            onward = self.continuations.get((arrived, floor))
+            if onward:
+                target, destination, walk, trip_start = onward.pop(0)
+                messages.append((now + walk, self.bank, self.sent, target, destination, trip_start))
+                self.sent += 1
+                continue
+            started = self.trip_starts.get((arrived, floor))
+            if started:
+                self.transfer_journeys.append(now - started.pop(0))
+        self.state.alighted = []
+        return messages
+
+    def summarise(self) -> dict:
+        summary = self.simulation.summarise(self.state)
+        summary['transfer_journeys'] = self.transfer_journeys
+        summary['events'] = self.events
+        return summary
+
+class Partition:
+    """The banks one worker owns"""
+
+    def __init__(self, campus: Campus, banks: List[int], duration: float):
+        self.runners = {bank: BankRunner(campus, bank, duration) for bank in banks}
+
+    def next_time(self) -> float:
+        return min(runner.next_time() for runner in self.runners.values())
+
+    def advance(self, until: float, inbound: List[tuple]) -> Tuple[List[tuple], float]:
+        """Deliver the window's inbound messages, run every bank to `until`, return (outbound, next event time)"""
+        for message in inbound:
+            self.runners[message[3]].deliver(message)
+        outbound = []
+        for runner in self.runners.values():
+            runner.run_before(until)
+            outbound.extend(runner.drain())
+        return outbound, self.next_time()
+
+    def summarise(self) -> Dict[int, dict]:
+        return {bank: runner.summarise() for bank, runner in self.runners.items()}
+
+def _partition_worker(connection, campus: Campus, banks: List[int], duration: float):
+    """Worker process: own a partition and answer window requests until told to finish"""
+    partition = Partition(campus, banks, duration)
+    connection.send(partition.next_time())
+    while True:
+        command = connection.recv()
+        if command[0] == 'advance':
+            connection.send(partition.advance(command[1], command[2]))
+        else:
+            connection.send(partition.summarise())
+            connection.close()
+            return
+
+class _LocalPartition:
+    """In-process partition behind the same submit/collect interface as a worker"""
+
+    def __init__(self, campus: Campus, banks: List[int], duration: float):
+        self.partition = Partition(campus, banks, duration)
+        self.reply = self.partition.next_time()
+
+    def submit(self, command: tuple):
+        if command[0] == 'advance':
+            self.reply = self.partition.advance(command[1], command[2])
+        else:
+            self.reply = self.partition.summarise()
+
+    def collect(self):
+        return self.reply
+
+class _RemotePartition:
+    def __init__(self, context, campus: Campus, banks: List[int], duration: float):
+        self.connection, child = context.Pipe()
+        self.process = context.Process(target=_partition_worker, args=(child, campus, banks, duration), daemon=True)
+        self.process.start()
+        child.close()
+
+    def submit(self, command: tuple):
+        self.connection.send(command)
+
+    def collect(self):
+        return self.connection.recv()
+
+    def join(self):
+        self.connection.close()
+        self.process.join()
+
+def partition_banks(campus: Campus, workers: int) -> List[List[int]]:
+    """Assign banks to workers, heaviest expected traffic first onto the least loaded worker"""
+    workers = max(1, min(workers, len(campus.banks)))
+    loads = [(0.0, w) for w in range(workers)]
+    partitions = [[] for _ in range(workers)]
+    weight = lambda b: campus.banks[b].arrival_rate + 2 * campus.banks[b].transfer_rate
+    for bank in sorted(range(len(campus.banks)), key=lambda b: (-weight(b), b)):
+        load, worker = heapq.heappop(loads)
+        partitions[worker].append(bank)
+        heapq.heappush(loads, (load + weight(bank), worker))
+    return [sorted(p) for p in partitions]
+
+def _campus_result(summaries: Dict[int, dict], elapsed: float) -> dict:
+    banks = [summaries[b] for b in sorted(summaries)]
+    waits = sorted(w for s in banks for w in s['waits'])
+    transfers = [j for s in banks for j in s['transfer_journeys']]
+    return {
+        'passengers_served': len(waits),
+        'mean_wait': statistics.mean(waits) if waits else 0.0,
+        'p95_wait': waits[min(len(waits) - 1, int(0.95 * len(waits)))] if waits else 0.0,
+        'transfers': len(transfers),
+        'mean_transfer_journey': statistics.mean(transfers) if transfers else 0.0,
+        'end_time': max(s['end_time'] for s in banks),
+        'events': sum(s['events'] for s in banks),
+        'banks': banks,
+        'elapsed': elapsed
+    }
+
+def run_campus_parallel(campus: Campus, duration: float, workers: int = 1) -> dict:
+    """Conservative parallel simulation of a campus, synchronised in time windows.
+
+    Each window starts at the campus-wide earliest pending event T (the
+    lower bound on any timestamp still to be processed, so idle stretches
+    are skipped) and covers [T, T + lookahead). Within it every partition
+    runs independently: a message sent from time t >= T arrives at
+    t + walk >= T + lookahead, so it can only matter to a later window.
+    Messages are exchanged at the window barrier and delivered in
+    (time, source bank, sequence) order. Window boundaries depend only on
+    the campus, not on how banks are split, so the result is identical
+    for any number of workers and matches run_campus_sequential.
+
+    Windows are used rather than null messages: every bank can reach every
+    other, so null messages would cost workers^2 messages per round where
+    a barrier costs one exchange per worker.
+    """
+    start_time = time.perf_counter()
+    lookahead = campus.lookahead()
+    partitions = partition_banks(campus, workers)
+    owner = {bank: w for w, banks in enumerate(partitions) for bank in banks}
+    if len(partitions) == 1:
+        proxies = [_LocalPartition(campus, partitions[0], duration)]
+    else:
+        context = multiprocessing.get_context()
+        proxies = [_RemotePartition(context, campus, banks, duration) for banks in partitions]
+
+    next_times = [proxy.collect() for proxy in proxies]
+    pending = []  # Messages waiting for their target's next window
+    windows = messages = 0
+    try:
+        while True:
+            lower_bound = min(next_times + [m[0] for m in pending])
+            if lower_bound == float('inf'):
+                break
+            until = lower_bound + lookahead
+            inbound = [[] for _ in proxies]
+            for message in sorted(pending):
+                inbound[owner[message[3]]].append(message)
+            pending = []
+            for proxy, messages_in in zip(proxies, inbound):
+                proxy.submit(('advance', until, messages_in))
+            for w, proxy in enumerate(proxies):
+                outbound, next_times[w] = proxy.collect()
+                pending.extend(outbound)
+                messages += len(outbound)
+            windows += 1
+
+        summaries = {}
+        for proxy in proxies:
+            proxy.submit(('finish',))
+        for proxy in proxies:
+            summaries.update(proxy.collect())
+    finally:
+        for proxy in proxies:
+            if isinstance(proxy, _RemotePartition):
+                proxy.join()
+
+    result = _campus_result(summaries, time.perf_counter() - start_time)
+    result.update({'workers': len(partitions), 'lookahead': lookahead, 'windows': windows, 'messages': messages})
+    return result
+
+def run_campus_sequential(campus: Campus, duration: float) -> dict:
+    """Reference run: one global event loop, every message delivered the moment it is sent"""
+    start_time = time.perf_counter()
+    runners = [BankRunner(campus, bank, duration) for bank in range(len(campus.banks))]
+    queue = [(runner.next_time(), runner.bank) for runner in runners]
+    heapq.heapify(queue)
+    while queue:
+        t, bank = heapq.heappop(queue)
+        runner = runners[bank]
+        if t == float('inf'):
+            break
+        if t != runner.next_time():
+            continue  # Stale entry: a delivery moved this bank's next event earlier
+        runner.step()
+        for message in runner.drain():
+            target = runners[message[3]]
+            target.deliver(message)
+            heapq.heappush(queue, (target.next_time(), target.bank))
+        heapq.heappush(queue, (runner.next_time(), bank))
+    return _campus_result({runner.bank: runner.summarise() for runner in runners}, time.perf_counter() - start_time)
+
+def demonstrate_campus_pdes():
+    """Run one large campus sequentially and in parallel partitions"""
+    print("=== Campus Parallel Simulation Demonstration ===\n")
+
+    num_banks, duration = 24, 3600
+    banks = [BankSpec(num_floors=20, num_cars=4, car_capacity=12, arrival_rate=0.15, transfer_rate=0.03)
+             for _ in range(num_banks)]
+    campus = Campus(banks, seed=3)
+    print(f"{num_banks} banks of 20 floors and 4 cars, one hour of traffic, lookahead {campus.lookahead():.0f}s\n")
+
+    reference = run_campus_sequential(campus, duration)
+    print(f"Sequential: {reference['passengers_served']} passengers, {reference['transfers']} transfers, "
+          f"{reference['events']} events in {reference['elapsed']:.2f}s")
+    print(f"  mean wait {reference['mean_wait']:.1f}s, mean transfer journey {reference['mean_transfer_journey']:.1f}s\n")
+
+    print(f"{'Workers':<9}{'Time (s)':>10}{'Speedup':>9}{'Windows':>9}{'Messages':>10}{'Events/window':>15}  Identical")
+    print("-" * 73)
+    for workers in (1, 2, 4, 8):
+        result = run_campus_parallel(campus, duration, workers)
+        identical = all(a['waits'] == b['waits'] and a['transfer_journeys'] == b['transfer_journeys']
+                        for a, b in zip(result['banks'], reference['banks']))
+        print(f"{result['workers']:<9}{result['elapsed']:>10.2f}{reference['elapsed'] / result['elapsed']:>9.2f}"
+              f"{result['windows']:>9}{result['messages']:>10}{result['events'] / result['windows']:>15.0f}  "
+              f"{'yes' if identical else 'NO'}")
+
+if __name__ == "__main__":
+    demonstrate_campus_pdes()
@@ -0,0 +1,65 @@
+import unittest
+from traffic_simulation import GroupSimulation
+from campus_pdes import (BankSpec, Campus, TransferArrivals, partition_banks,
+                         run_campus_parallel, run_campus_sequential)
+
+class TestCampusPDES(unittest.TestCase):
+
+    def setUp(self):
+        banks = [BankSpec(num_floors=8, num_cars=2, arrival_rate=0.05, transfer_rate=0.02) for _ in range(4)]
+        self.campus = Campus(banks, seed=11)
+        self.duration = 900
+
+    def test_lookahead_is_shortest_walk(self):
+        """Test the lookahead is the shortest walk between two different banks"""
+        walks = [[0, 90, 45], [90, 0, 30], [45, 30, 0]]
+        self.assertEqual(Campus([BankSpec()] * 3, walk_times=walks).lookahead(), 30)
+        with self.assertRaises(ValueError):
+            Campus([BankSpec()] * 2, walk_times=[[0, 0], [0, 0]])
+
+    def test_injected_arrivals_merge_in_time_order(self):
+        """Test injected passengers interleave with the replayed list, replayed first on a tie"""
+        source = TransferArrivals([(1.0, 1, 5), (4.0, 3, 1)])
+        source.inject((4.0, 1, 7))
+        source.inject((2.0, 1, 6))
+        self.assertEqual([source.pop() for _ in range(4)], [(1.0, 1, 5), (2.0, 1, 6), (4.0, 3, 1), (4.0, 1, 7)])
+        self.assertEqual(source.peek_time(), float('inf'))
+
+    def test_alighted_records_each_passenger(self):
+        """Test the alighting hook sees every passenger at their destination"""
+        simulation = GroupSimulation(num_floors=6, num_cars=1)
+        state = simulation.start([(0.0, 1, 4), (1.0, 2, 6)])
+        state.alighted = []
+        simulation.advance(state, float('inf'))
+        self.assertEqual(sorted((arrived, floor) for _, arrived, floor in state.alighted), [(0.0, 4), (1.0, 6)])
+
+    def test_partition_covers_every_bank_once(self):
+        """Test banks are spread over the workers without loss or duplication"""
+        partitions = partition_banks(self.campus, 3)
+        self.assertEqual(len(partitions), 3)
+        self.assertEqual(sorted(b for p in partitions for b in p), [0, 1, 2, 3])
+        self.assertEqual(len(partition_banks(self.campus, 10)), 4)
+
+    def test_windows_match_sequential_run(self):
+        """Test the windowed run reproduces the global event loop exactly"""
+        reference = run_campus_sequential(self.campus, self.duration)
+        result = run_campus_parallel(self.campus, self.duration, workers=1)
+        for bank, expected in zip(result['banks'], reference['banks']):
+            self.assertEqual(bank['waits'], expected['waits'])
+            self.assertEqual(bank['transfer_journeys'], expected['transfer_journeys'])
+        self.assertGreater(result['transfers'], 0)
+        self.assertEqual(result['messages'], result['transfers'])
+
+    def test_result_independent_of_workers(self):
+        """Test worker processes give the same result as a single partition"""
+        single = run_campus_parallel(self.campus, self.duration, workers=1)
+        split = run_campus_parallel(self.campus, self.duration, workers=3)
+        self.assertEqual(split['workers'], 3)
+        self.assertEqual(split['windows'], single['windows'])
+        self.assertEqual([b['waits'] for b in split['banks']], [b['waits'] for b in single['banks']])
+        # Every transfer walks at least the lookahead between its two rides
+        self.assertGreaterEqual(min(j for b in split['banks'] for j in b['transfer_journeys']),
+                                self.campus.lookahead())
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,169 @@
+from typing import List, Dict, Optional
+import time
+from traffic_simulation import TimingModel, TrafficGenerator, GroupSimulation
+
+class UpPeakEstimator:
+    """Analytic up-peak lift-traffic estimates (round trip time, interval, waiting time)
+
+    Uses the classical formulas: expected stops S = N(1 - (1 - 1/N)^P),
+    highest reversal floor H = N - sum_{i<N} (i/N)^P, and
+    RTT = 2*H*tv + (S + 1)*ts + 2*P*tp, where P is the average car load.
+    The average wait follows Barney's up-peak approximation in terms of
+    the interval and the car load factor.
+    """
+
+    def __init__(self, timing: Optional[TimingModel] = None, max_load_factor: float = 0.8):
+        self.timing = timing or TimingModel()
+        self.max_load_factor = max_load_factor
+
+    def round_trip_time(self, num_floors: int, passengers: float) -> float:
+        timing = self.timing
+        served = max(1, num_floors - 1)  # Floors above the lobby
+        if passengers <= 0:
+            return timing.door_cycle
+        stops = served * (1 - (1 - 1 / served) ** passengers)
+        highest = served - sum((i / served) ** passengers for i in range(1, served))
+        return (2 * highest * timing.seconds_per_floor +
+                (stops + 1) * timing.door_cycle +
+                2 * passengers * timing.seconds_per_passenger)
+
+    def estimate(self, num_floors: int, num_cars: int, car_capacity: int, arrival_rate: float) -> dict:
+        """Score one configuration for a given up-peak arrival rate (passengers/second)"""
+        # Average load P satisfies P = arrival_rate * interval(P); solve by fixed-point iteration
+        passengers = 1.0
+        for _ in range(50):
+            interval = self.round_trip_time(num_floors, passengers) / num_cars
+            updated = min(float(car_capacity), arrival_rate * interval)
+            if abs(updated - passengers) < 1e-6:
+                break
+            passengers = updated
+
+        rtt = self.round_trip_time(num_floors, passengers)
+        interval = rtt / num_cars
+        load_factor = passengers / car_capacity
+        handling_capacity = 300 * self.max_load_factor * car_capacity * num_cars / \
+            self.round_trip_time(num_floors, self.max_load_factor * car_capacity)
+        saturated = load_factor >= self.max_load_factor and arrival_rate * 300 > handling_capacity
+
+        if saturated:
+            mean_wait = float('inf')
+        elif load_factor < 0.5:
+            mean_wait = 0.4 * interval
+        else:
+            mean_wait = (0.4 + (1.8 * load_factor - 0.77) ** 2) * interval
+
+        return {
+            'round_trip_time': rtt,
+            'interval': interval,
+            'car_load': passengers,
+            'load_factor': load_factor,
+            'handling_capacity_5min': handling_capacity,
+            'mean_wait': mean_wait,
+            'saturated': saturated
+        }
+
+def config_grid(num_cars: List[int], car_capacities: List[int]) -> List[Dict[str, int]]:
+    """Cartesian product of bank sizes and car capacities"""
+    return [{'num_cars': cars, 'car_capacity': capacity}
+            for cars in num_cars for capacity in car_capacities]
+
+class CapacitySweep:
+    """Parameter sweep that simulates only configurations the analytic estimator finds promising"""
+
+    def __init__(self, num_floors: int = 10, arrival_rate: float = 0.15,
+                 timing: Optional[TimingModel] = None, duration: float = 3600, seed: int = 0):
+        self.num_floors = num_floors
+        self.arrival_rate = arrival_rate
+        self.timing = timing or TimingModel()
+        self.duration = duration
+        self.seed = seed
+        self.estimator = UpPeakEstimator(self.timing)
+
+    def _config_cost(self, config: Dict[str, int]) -> int:
+        return config['num_cars'] * config['car_capacity']
+
+    def prune(self, configs: List[Dict[str, int]], target_wait: Optional[float] = None,
+              margin: float = 1.5) -> List[Dict]:
+        """Return the promising region of a sweep.
+
+        Without a target, keep unsaturated configurations whose estimated wait
+        is within `margin` of the best estimate. With a target, keep those
+        estimated to come within `margin` of it that cost (cars x capacity) at
+        most `margin` times the cheapest configuration estimated to meet it;
+        bigger banks are over-provisioned and not worth simulating.
+        """
+        scored = []
+        for config in configs:
+            estimate = self.estimator.estimate(self.num_floors, config['num_cars'],
+                                               config['car_capacity'], self.arrival_rate)
+            if not estimate['saturated']:
+                scored.append((config, estimate))
+        if not scored:
+            return []
+
+        if target_wait is None:
+            best = min(e['mean_wait'] for _, e in scored)
+            return [{'config': c, 'estimate': e} for c, e in scored if e['mean_wait'] <= best * margin]
+
+        candidates = [(c, e) for c, e in scored if e['mean_wait'] <= target_wait * margin]
+        meeting = [self._config_cost(c) for c, e in candidates if e['mean_wait'] <= target_wait]
+        max_cost = min(meeting) * margin if meeting else float('inf')
+        return [{'config': c, 'estimate': e} for c, e in candidates if self._config_cost(c) <= max_cost]
+
+    def run(self, configs: List[Dict[str, int]], target_wait: Optional[float] = None,
+            margin: float = 1.5) -> dict:
+        """Estimate every configuration, simulate the promising ones, and rank them"""
+        start = time.time()
+        promising = self.prune(configs, target_wait, margin)
+        estimate_time = time.time() - start
+
+        arrivals = TrafficGenerator(self.num_floors, self.arrival_rate, 'up_peak',
+                                    seed=self.seed).generate(self.duration)
+
+        start = time.time()
+        results = []
+        for entry in promising:
+            config = entry['config']
+            simulation = GroupSimulation(self.num_floors, config['num_cars'], config['car_capacity'], self.timing)
+            simulated = simulation.run(arrivals)
+            results.append({
+                'config': config,
+                'estimated_wait': entry['estimate']['mean_wait'],
+                'simulated_wait': simulated['mean_wait'],
+                'p95_wait': simulated['p95_wait'],
+                'meets_target': target_wait is None or simulated['mean_wait'] <= target_wait
+            })
+        simulate_time = time.time() - start
+
+        results.sort(key=lambda r: (not r['meets_target'], self._config_cost(r['config']), r['simulated_wait']))
+
+        return {
+            'configurations': len(configs),
+            'simulated': len(results),
+            'pruned': len(configs) - len(results),
+            'estimate_time': estimate_time,
+            'simulate_time': simulate_time,
+            'results': results
+        }
+
+def demonstrate_capacity_sweep():
+    """Demonstrate an analytically pruned capacity sweep"""
+    print("=== Capacity Sweep Demonstration ===\n")
+
+    sweep = CapacitySweep(num_floors=12, arrival_rate=0.2)
+    configs = config_grid(num_cars=list(range(1, 9)), car_capacities=[8, 10, 13, 16, 21])
+    outcome = sweep.run(configs, target_wait=20.0)
+
+    print(f"Configurations: {outcome['configurations']}, simulated: {outcome['simulated']}, "
+          f"pruned: {outcome['pruned']}")
+    print(f"Analytic scoring: {outcome['estimate_time'] * 1e6 / outcome['configurations']:.1f} us/config, "
+          f"simulation: {outcome['simulate_time']:.2f}s total\n")
+
+    print(f"{'Cars':<6} {'Capacity':<10} {'Est. wait':<12} {'Sim. wait':<12} {'P95 wait':<10} {'Target'}")
+    for result in outcome['results']:
+        config = result['config']
+        print(f"{config['num_cars']:<6} {config['car_capacity']:<10} {result['estimated_wait']:<12.1f} "
+              f"{result['simulated_wait']:<12.1f} {result['p95_wait']:<10.1f} {'yes' if result['meets_target'] else 'no'}")
+
+if __name__ == "__main__":
+    demonstrate_capacity_sweep()
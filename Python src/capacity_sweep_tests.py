@@ -0,0 +1,64 @@
+import unittest
+from traffic_simulation import TimingModel
+from capacity_sweep import UpPeakEstimator, CapacitySweep, config_grid
+
+class TestUpPeakEstimator(unittest.TestCase):
+
+    def setUp(self):
+        self.estimator = UpPeakEstimator(TimingModel())
+
+    def test_round_trip_grows_with_load(self):
+        """Test fuller cars make longer round trips"""
+        self.assertLess(self.estimator.round_trip_time(10, 4), self.estimator.round_trip_time(10, 10))
+
+    def test_single_passenger_round_trip(self):
+        """Test RTT for one passenger against a hand calculation"""
+        timing = TimingModel(seconds_per_floor=1.0, door_cycle=2.0, seconds_per_passenger=0.5)
+        estimator = UpPeakEstimator(timing)
+        # N=4 served floors, P=1: S=1, H=4-(1+2+3)/4=2.5, RTT=2*2.5 + 2*2 + 2*0.5
+        self.assertAlmostEqual(estimator.round_trip_time(5, 1), 10.0)
+
+    def test_more_cars_shorter_interval(self):
+        """Test interval and wait fall as cars are added"""
+        two = self.estimator.estimate(10, 2, 12, 0.1)
+        four = self.estimator.estimate(10, 4, 12, 0.1)
+        self.assertLess(four['interval'], two['interval'])
+        self.assertLess(four['mean_wait'], two['mean_wait'])
+
+    def test_saturation_detected(self):
+        """Test overloaded banks are flagged with infinite wait"""
+        estimate = self.estimator.estimate(20, 1, 8, 1.0)
+        self.assertTrue(estimate['saturated'])
+        self.assertEqual(estimate['mean_wait'], float('inf'))
+
+class TestCapacitySweep(unittest.TestCase):
+
+    def test_grid(self):
+        """Test configuration grid covers every combination"""
+        self.assertEqual(len(config_grid([1, 2, 3], [8, 10])), 6)
+
+    def test_prune_removes_saturated_and_oversized(self):
+        """Test pruning keeps only feasible, near-minimal configurations"""
+        sweep = CapacitySweep(num_floors=12, arrival_rate=0.2)
+        configs = config_grid(list(range(1, 9)), [8, 10, 13, 16, 21])
+        promising = sweep.prune(configs, target_wait=20.0)
+
+        self.assertGreater(len(promising), 0)
+        self.assertLess(len(promising), len(configs))
+        kept = [(p['config']['num_cars'], p['config']['car_capacity']) for p in promising]
+        self.assertNotIn((1, 8), kept)   # Saturated
+        self.assertNotIn((8, 21), kept)  # Far over-provisioned
+
+    def test_run_simulates_only_promising(self):
+        """Test the sweep simulates the pruned set and ranks target-meeting configs first"""
+        sweep = CapacitySweep(num_floors=10, arrival_rate=0.15, duration=1800)
+        outcome = sweep.run(config_grid([1, 2, 3, 4, 6], [8, 12]), target_wait=20.0)
+
+        self.assertEqual(outcome['simulated'] + outcome['pruned'], outcome['configurations'])
+        self.assertGreater(outcome['pruned'], 0)
+        self.assertGreater(outcome['simulated'], 0)
+        self.assertEqual(len(outcome['results']), outcome['simulated'])
+        self.assertTrue(outcome['results'][0]['meets_target'])
+
+if __name__ == "__main__":
+    unittest.main()
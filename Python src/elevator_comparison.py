@@ -1,6 +1,6 @@
 import time
 import random
-from typing import List, Tuple
+from typing import List, Tuple, Optional
 from optimized_elevator import OptimizedElevator
 from cached_elevator import CachedElevator
 
@@ -10,15 +10,16 @@ class ElevatorComparison:
     def __init__(self):
         self.results = {}
 
-    def simulate_office_building_day(self, elevator, num_employees: int = 100) -> dict:
-        """Simulate a full day in an office building"""
+    def simulate_office_building_day(self, elevator, num_employees: int = 100, seed: Optional[int] = None) -> dict:
+        """Simulate a full day in an office building (same seed -> same day of traffic)"""
+        rng = random.Random(seed)
         movements = 0
         total_time = 0
         requests_processed = 0
 
         # Morning rush (8-10 AM) - everyone goes up
         print("  Simulating morning rush...")
-        morning_requests = [(1, random.randint(2, 10)) for _ in range(num_employees)]
+        morning_requests = [(1, rng.randint(2, 10)) for _ in range(num_employees)]
 
         start_time = time.time()
         for from_floor, to_floor in morning_requests:
@@ -27,7 +28,7 @@ class ElevatorComparison:
 
             if isinstance(elevator, CachedElevator):
                 # Cached elevator method with user_id and from_floor
-                elevator.add_floor_request(to_floor, f"emp_{random.randint(1, num_employees)}", from_floor)
+                elevator.add_floor_request(to_floor, f"emp_{rng.randint(1, num_employees)}", from_floor)
             else:
                 # Optimized elevator method
                 elevator.add_floor_request(to_floor)
@@ -46,9 +47,9 @@ class ElevatorComparison:
         lunch_requests = []
         for _ in range(num_employees // 2):
             # Some go down to lobby
-            lunch_requests.append((random.randint(2, 10), 1))
+            lunch_requests.append((rng.randint(2, 10), 1))
             # Some go to different floors
-            lunch_requests.append((random.randint(2, 10), random.randint(2, 10)))
+            lunch_requests.append((rng.randint(2, 10), rng.randint(2, 10)))
 
         start_time = time.time()
         for from_floor, to_floor in lunch_requests:
@@ -56,7 +57,7 @@ class ElevatorComparison:
                 elevator.current_floor = from_floor
 
             if isinstance(elevator, CachedElevator):
-                elevator.add_floor_request(to_floor, f"emp_{random.randint(1, num_employees)}", from_floor)
+                elevator.add_floor_request(to_floor, f"emp_{rng.randint(1, num_employees)}", from_floor)
             else:
                 elevator.add_floor_request(to_floor)
 
@@ -71,7 +72,7 @@ class ElevatorComparison:
 
         # Evening rush (5-6 PM) - everyone goes down
         print("  Simulating evening rush...")
-        evening_requests = [(random.randint(2, 10), 1) for _ in range(num_employees)]
+        evening_requests = [(rng.randint(2, 10), 1) for _ in range(num_employees)]
 
         start_time = time.time()
         for from_floor, to_floor in evening_requests:
@@ -79,7 +80,7 @@ class ElevatorComparison:
                 elevator.current_floor = from_floor
 
             if isinstance(elevator, CachedElevator):
-                elevator.add_floor_request(to_floor, f"emp_{random.randint(1, num_employees)}", from_floor)
+                elevator.add_floor_request(to_floor, f"emp_{rng.randint(1, num_employees)}", from_floor)
             else:
                 elevator.add_floor_request(to_floor)
 
@@ -105,26 +106,31 @@ class ElevatorComparison:
             'evening_time': evening_time
         }
 
-    def compare_implementations(self) -> dict:
-        """Compare all elevator implementations"""
+    def compare_implementations(self, seed: Optional[int] = None) -> dict:
+        """Compare all elevator implementations on common random numbers: every
+        implementation replays the same simulated day, so differences come from
+        the implementations rather than from the traffic"""
         print("=== Elevator Implementation Comparison ===\n")
 
+        if seed is None:
+            seed = random.getrandbits(32)
+
         results = {}
 
         # Test 1: Optimized Elevator
         print("Testing Optimized Elevator...")
         optimized = OptimizedElevator(num_floors=10, starting_floor=1)
-        results['optimized'] = self.simulate_office_building_day(optimized)
+        results['optimized'] = self.simulate_office_building_day(optimized, seed=seed)
 
         # Test 2: Cached Elevator
         print("Testing Cached Elevator...")
         cached = CachedElevator(num_floors=10, starting_floor=1, enable_caching=True)
-        results['cached'] = self.simulate_office_building_day(cached)
+        results['cached'] = self.simulate_office_building_day(cached, seed=seed)
 
         # Test 3: Cached Elevator without caching (for comparison)
         print("Testing Cached Elevator (caching disabled)...")
         cached_disabled = CachedElevator(num_floors=10, starting_floor=1, enable_caching=False)
-        results['cached_no_cache'] = self.simulate_office_building_day(cached_disabled)
+        results['cached_no_cache'] = self.simulate_office_building_day(cached_disabled, seed=seed)
 
         # Get cache performance if available
         if hasattr(cached, 'cache') and cached.cache:
@@ -181,8 +187,10 @@ class ElevatorComparison:
             if 'cache_energy_saved' in results:
                 print(f"{'Energy Saved':<30}: {results['cache_energy_saved']:.2f} units")
 
-    def run_stress_test(self, num_requests: int = 10000) -> dict:
-        """Run stress test with many requests"""
+    def run_stress_test(self, num_requests: int = 10000, seed: Optional[int] = None) -> dict:
+        """Run stress test with many requests (every elevator sees the same request stream)"""
+        if seed is None:
+            seed = random.getrandbits(32)
         print(f"\n=== Stress Test ({num_requests:,} requests) ===")
 
         elevators = {
@@ -194,13 +202,14 @@ class ElevatorComparison:
 
         for name, elevator in elevators.items():
             print(f"Testing {name} elevator...")
+            rng = random.Random(seed)
 
             start_time = time.time()
             requests_processed = 0
 
             for i in range(num_requests):
-                from_floor = random.randint(1, 50)
-                to_floor = random.randint(1, 50)
+                from_floor = rng.randint(1, 50)
+                to_floor = rng.randint(1, 50)
 
                 if hasattr(elevator, 'current_floor'):
                     elevator.current_floor = from_floor
@@ -133,6 +133,39 @@ class TestOptimizedElevator(unittest.TestCase):
         status = self.elevator.get_status()
         self.assertEqual(status["pending_requests"], [3])  # Should only appear once
 
+    def test_cancel_request(self):
+        """Test cancelled calls are skipped and counted"""
+        self.elevator.add_multiple_requests([2, 3, 4])
+        self.assertTrue(self.elevator.cancel_request(3))
+        self.assertFalse(self.elevator.cancel_request(3))  # No longer pending
+
+        movements = self.elevator.process_requests()
+        self.assertNotIn("Arrived at floor 3 - Doors open", movements)
+        self.assertEqual(self.elevator.current_floor, 4)
+        self.assertEqual(self.elevator.get_status()["filtered_calls"]["cancelled"], 1)
+
+    def test_per_passenger_call_limit(self):
+        """Test car calls beyond the per-passenger quota are filtered"""
+        self.big_elevator.update_load(1)
+        results = self.big_elevator.add_multiple_requests([1, 2, 3, 4, 6, 7])
+
+        self.assertEqual(results, [True, True, True, False, False, False])
+        self.assertEqual(self.big_elevator.get_status()["filtered_calls"]["per_passenger"], 3)
+
+    def test_empty_car_calls(self):
+        """Test an empty car keeps one call and drops the rest when it empties"""
+        self.big_elevator.update_load(0)
+        self.assertTrue(self.big_elevator.add_floor_request(8))
+        self.assertFalse(self.big_elevator.add_floor_request(9))
+        self.assertEqual(self.big_elevator.get_status()["filtered_calls"]["inconsistent_load"], 1)
+
+        self.big_elevator.update_load(2)
+        self.big_elevator.add_multiple_requests([2, 3])
+        self.big_elevator.update_load(0)
+        status = self.big_elevator.get_status()
+        self.assertEqual(status["pending_requests"], [])
+        self.assertEqual(status["filtered_calls"]["ghost"], 3)
+
 def run_performance_test():
     """Test performance with large number of requests"""
     print("\n=== Performance Test ===")
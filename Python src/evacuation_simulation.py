@@ -0,0 +1,181 @@
+from typing import List, Dict, Optional
+from concurrent.futures import ProcessPoolExecutor
+import heapq
+import os
+import random
+import statistics
+from traffic_simulation import TimingModel
+
+class EvacuationTiming(TimingModel):
+    """Timing model for evacuation shuttles with per-trip random variation"""
+
+    def __init__(self, seconds_per_floor: float = 1.5, door_cycle: float = 6.0,
+                 seconds_per_passenger: float = 1.0, jitter: float = 0.1):
+        super().__init__(seconds_per_floor, door_cycle, seconds_per_passenger)
+        self.jitter = jitter  # Relative random variation applied to each trip
+
+class EvacuationController:
+    """Shuttle-to-discharge dispatch policy for a bank of cars during evacuation"""
+
+    def __init__(self, discharge_floor: int = 1, priority_floors: Optional[List[int]] = None):
+        self.discharge_floor = discharge_floor
+        self.priority_floors = list(priority_floors or [])
+
+    def next_floor(self, remaining: Dict[int, int]) -> Optional[int]:
+        """Pick the next pickup floor for a car waiting at the discharge floor.
+
+        Priority floors are served first (in the order given), then the
+        highest floor with people still waiting. Passengers are reserved
+        when a car is dispatched, so two cars never race for the same group.
+        """
+        for floor in self.priority_floors:
+            if remaining.get(floor, 0) > 0:
+                return floor
+
+        candidates = [f for f, waiting in remaining.items() if f != self.discharge_floor and waiting > 0]
+        if candidates:
+            return max(candidates)
+        return None
+
+class EvacuationSimulation:
+    """Event-driven evacuation of a building with all cars shuttling to the discharge floor"""
+
+    def __init__(self, num_floors: int = 10, num_cars: int = 2, car_capacity: int = 10,
+                 floor_populations: Optional[Dict[int, int]] = None,
+                 priority_floors: Optional[List[int]] = None, discharge_floor: int = 1,
+                 timing: Optional[EvacuationTiming] = None):
+        if num_cars < 1:
+            raise ValueError("an evacuation needs at least one car")
+        self.num_floors = num_floors
+        self.num_cars = num_cars
+        self.car_capacity = car_capacity
+        self.discharge_floor = discharge_floor
+        self.timing = timing or EvacuationTiming()
+        self.controller = EvacuationController(discharge_floor, priority_floors)
+
+        if floor_populations is None:
+            floor_populations = {f: 20 for f in range(1, num_floors + 1) if f != discharge_floor}
+        self.floor_populations = dict(floor_populations)
+
+    def _randomised_populations(self, rng: random.Random, spread: float) -> Dict[int, int]:
+        """Draw actual occupancy around the nominal population of each floor"""
+        populations = {}
+        for floor, nominal in self.floor_populations.items():
+            low = int(nominal * (1 - spread))
+            high = int(round(nominal * (1 + spread)))
+            populations[floor] = rng.randint(max(0, low), max(0, high))
+        return populations
+
+    def run(self, seed: Optional[int] = None, population_spread: float = 0.0) -> dict:
+        """Run one evacuation and return clearance times"""
+        rng = random.Random(seed)
+        timing = self.timing
+
+        if population_spread > 0:
+            remaining = self._randomised_populations(rng, population_spread)
+        else:
+            remaining = dict(self.floor_populations)
+        remaining = {f: n for f, n in remaining.items() if n > 0 and f != self.discharge_floor}
+
+        evacuated = 0
+        total_people = sum(remaining.values())
+        floor_clear_time = {}
+        trips = 0
+
+        # Every car starts at the discharge floor, free at t=0
+        car_events = [(0.0, car) for car in range(self.num_cars)]
+        heapq.heapify(car_events)
+        clearance_time = 0.0
+
+        while car_events and evacuated < total_people:
+            now, car = heapq.heappop(car_events)
+
+            target = self.controller.next_floor(remaining)
+            if target is None:
+                # Other cars have already picked up every waiting passenger
+                continue
+
+            noise = 1.0 + rng.uniform(-timing.jitter, timing.jitter)
+
+            travel = timing.travel_time(self.discharge_floor, target) * noise
+            arrive_pickup = now + travel
+            boarding = min(self.car_capacity, remaining[target])
+            leave_pickup = arrive_pickup + timing.transfer_time(boarding) * noise
+
+            remaining[target] -= boarding
+            if remaining[target] == 0:
+                del remaining[target]
+                floor_clear_time[target] = leave_pickup
+
+            arrive_discharge = leave_pickup + travel
+            done = arrive_discharge + timing.transfer_time(boarding) * noise
+
+            evacuated += boarding
+            trips += 1
+            clearance_time = max(clearance_time, done)
+            heapq.heappush(car_events, (done, car))
+
+        return {
+            'clearance_time': clearance_time,
+            'people_evacuated': evacuated,
+            'trips': trips,
+            'floor_clear_time': floor_clear_time
+        }
+
+def _run_batch(args) -> List[float]:
+    """Worker entry point: run a batch of seeds and return their clearance times"""
+    simulation, seeds, population_spread = args
+    return [simulation.run(seed, population_spread)['clearance_time'] for seed in seeds]
+
+def clearance_time_distribution(simulation: EvacuationSimulation, num_runs: int = 1000,
+                                population_spread: float = 0.2, workers: Optional[int] = None,
+                                base_seed: int = 0) -> dict:
+    """Run many randomised evacuations in parallel and summarise clearance times"""
+    seeds = list(range(base_seed, base_seed + num_runs))
+
+    if workers == 1:
+        times = _run_batch((simulation, seeds, population_spread))
+    else:
+        num_batches = (workers or os.cpu_count() or 1) * 4
+        batches = [seeds[i::num_batches] for i in range(num_batches)]
+        times = []
+        with ProcessPoolExecutor(max_workers=workers) as pool:
+            for batch_times in pool.map(_run_batch, [(simulation, b, population_spread) for b in batches if b]):
+                times.extend(batch_times)
+
+    times.sort()
+
+    def percentile(p: float) -> float:
+        return times[min(len(times) - 1, int(p * len(times)))]
+
+    return {
+        'runs': len(times),
+        'mean': statistics.mean(times),
+        'stdev': statistics.stdev(times) if len(times) > 1 else 0.0,
+        'min': times[0],
+        'p50': percentile(0.50),
+        'p90': percentile(0.90),
+        'p95': percentile(0.95),
+        'max': times[-1]
+    }
+
+def demonstrate_evacuation():
+    """Demonstrate evacuation clearance time estimation"""
+    print("=== Evacuation Simulation Demonstration ===\n")
+
+    populations = {floor: 30 for floor in range(2, 11)}
+    simulation = EvacuationSimulation(num_floors=10, num_cars=3, car_capacity=12,
+                                      floor_populations=populations, priority_floors=[7])
+
+    result = simulation.run()
+    print(f"Nominal clearance time: {result['clearance_time']:.1f}s "
+          f"({result['people_evacuated']} people, {result['trips']} trips)")
+    print(f"Priority floor 7 cleared at {result['floor_clear_time'][7]:.1f}s\n")
+
+    print("Clearance time distribution over 2,000 randomised runs:")
+    summary = clearance_time_distribution(simulation, num_runs=2000)
+    for key, value in summary.items():
+        print(f"  {key:<6}: {value:.1f}" if isinstance(value, float) else f"  {key:<6}: {value}")
+
+if __name__ == "__main__":
+    demonstrate_evacuation()
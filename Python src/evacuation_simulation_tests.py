@@ -0,0 +1,91 @@
+import unittest
+from evacuation_simulation import (EvacuationSimulation, EvacuationController, EvacuationTiming,
+                                   clearance_time_distribution)
+
+class TestEvacuationController(unittest.TestCase):
+
+    def test_priority_floors_first(self):
+        """Test priority floors are served before higher floors"""
+        controller = EvacuationController(discharge_floor=1, priority_floors=[4])
+        self.assertEqual(controller.next_floor({4: 5, 9: 20}), 4)
+
+    def test_highest_floor_without_priority(self):
+        """Test top-down clearing order when no priority floor is waiting"""
+        controller = EvacuationController(discharge_floor=1, priority_floors=[4])
+        self.assertEqual(controller.next_floor({3: 5, 9: 20}), 9)
+
+    def test_nothing_left(self):
+        """Test no floor is returned once everyone is picked up"""
+        controller = EvacuationController()
+        self.assertIsNone(controller.next_floor({}))
+
+class TestEvacuationSimulation(unittest.TestCase):
+
+    def setUp(self):
+        self.timing = EvacuationTiming(seconds_per_floor=1.0, door_cycle=2.0,
+                                       seconds_per_passenger=0.5, jitter=0.0)
+
+    def test_everyone_evacuated(self):
+        """Test all occupants reach the discharge floor"""
+        populations = {2: 7, 5: 13, 8: 25}
+        simulation = EvacuationSimulation(num_floors=8, num_cars=2, car_capacity=10,
+                                          floor_populations=populations, timing=self.timing)
+        result = simulation.run(seed=1)
+        self.assertEqual(result['people_evacuated'], 45)
+        self.assertEqual(set(result['floor_clear_time']), {2, 5, 8})
+
+    def test_rejects_no_cars(self):
+        """Test a building without cars is rejected rather than cleared instantly"""
+        with self.assertRaises(ValueError):
+            EvacuationSimulation(num_cars=0)
+
+    def test_single_trip_clearance_time(self):
+        """Test clearance time of a single deterministic trip"""
+        simulation = EvacuationSimulation(num_floors=5, num_cars=1, car_capacity=10,
+                                          floor_populations={5: 4}, timing=self.timing)
+        result = simulation.run(seed=0)
+        # 4 floors up, load 4, 4 floors down, unload 4
+        self.assertAlmostEqual(result['clearance_time'], 4 + 4 + 4 + 4)
+        self.assertEqual(result['trips'], 1)
+
+    def test_more_cars_clear_faster(self):
+        """Test adding cars reduces clearance time"""
+        populations = {floor: 30 for floor in range(2, 11)}
+        one_car = EvacuationSimulation(num_cars=1, floor_populations=populations, timing=self.timing)
+        four_cars = EvacuationSimulation(num_cars=4, floor_populations=populations, timing=self.timing)
+        self.assertLess(four_cars.run(seed=0)['clearance_time'], one_car.run(seed=0)['clearance_time'])
+
+    def test_priority_floor_cleared_early(self):
+        """Test a priority floor is cleared before top-down order would reach it"""
+        populations = {floor: 20 for floor in range(2, 11)}
+        simulation = EvacuationSimulation(num_cars=2, floor_populations=populations,
+                                          priority_floors=[3], timing=self.timing)
+        clear = simulation.run(seed=0)['floor_clear_time']
+        self.assertLess(clear[3], clear[10])
+
+    def test_runs_are_reproducible(self):
+        """Test the same seed yields the same randomised run"""
+        simulation = EvacuationSimulation()
+        first = simulation.run(seed=42, population_spread=0.3)
+        second = simulation.run(seed=42, population_spread=0.3)
+        self.assertEqual(first['clearance_time'], second['clearance_time'])
+
+class TestClearanceDistribution(unittest.TestCase):
+
+    def test_parallel_matches_serial(self):
+        """Test parallel runs give the same distribution as a serial loop"""
+        simulation = EvacuationSimulation(num_cars=2)
+        serial = clearance_time_distribution(simulation, num_runs=50, workers=1)
+        parallel = clearance_time_distribution(simulation, num_runs=50, workers=2)
+        self.assertEqual(serial, parallel)
+
+    def test_percentiles_ordered(self):
+        """Test summary percentiles are monotonic"""
+        summary = clearance_time_distribution(EvacuationSimulation(), num_runs=100, workers=1)
+        self.assertEqual(summary['runs'], 100)
+        self.assertLessEqual(summary['min'], summary['p50'])
+        self.assertLessEqual(summary['p50'], summary['p95'])
+        self.assertLessEqual(summary['p95'], summary['max'])
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,85 @@
+import unittest
+from traffic_simulation import TimingModel, TrafficGenerator, GroupSimulation
+from lobby_batching import LobbyBatchingPolicy, AdaptiveLobbyBatching, handling_capacity
+
+class TestLobbyBatching(unittest.TestCase):
+
+    def setUp(self):
+        self.timing = TimingModel(seconds_per_floor=1.0, door_cycle=4.0, seconds_per_passenger=1.0)
+
+    def _run(self, arrivals, policy, num_cars=1, capacity=10):
+        simulation = GroupSimulation(num_floors=10, num_cars=num_cars, car_capacity=capacity,
+                                     timing=self.timing, departure_policy=policy)
+        return simulation.run(arrivals)
+
+    def test_hold_batches_lobby_passengers(self):
+        """Test passengers arriving during the hold ride in the same trip"""
+        arrivals = [(0.0, 1, 6), (8.0, 1, 6)]
+        unbatched = self._run(arrivals, None)
+        batched = self._run(arrivals, LobbyBatchingPolicy(load_fraction=0.5, max_hold=20.0))
+        self.assertEqual(batched['passengers_served'], 2)
+        self.assertEqual(batched['stops'], 2)  # One lobby stop, one drop-off
+        self.assertGreater(unbatched['stops'], batched['stops'])
+
+    def test_hold_ends_at_max_hold(self):
+        """Test a lone passenger leaves once the maximum hold time has passed"""
+        result = self._run([(0.0, 1, 6)], LobbyBatchingPolicy(load_fraction=0.5, max_hold=10.0))
+        # Held 10s from the start of boarding, then 5 floors of travel
+        self.assertAlmostEqual(result['mean_journey'], 10.0 + 5.0)
+        self.assertEqual(result['mean_wait'], 0.0)
+
+    def test_full_car_departs_early(self):
+        """Test reaching the load target ends the hold"""
+        arrivals = [(0.0, 1, 6), (0.0, 1, 7)]
+        result = self._run(arrivals, LobbyBatchingPolicy(load_fraction=0.2, max_hold=60.0), capacity=10)
+        self.assertLess(max(result['waits']), 1.0)
+        self.assertLess(result['end_time'], 30.0)
+
+    def test_one_car_loads_at_a_time(self):
+        """Test an idle second car leaves the lobby queue to the loading car"""
+        arrivals = [(0.0, 1, 6), (2.0, 1, 8), (4.0, 1, 9)]
+        result = self._run(arrivals, LobbyBatchingPolicy(load_fraction=0.3, max_hold=20.0), num_cars=2)
+        self.assertEqual(result['passengers_served'], 3)
+        self.assertEqual(result['stops'], 4)  # One lobby stop and three drop-offs
+
+    def test_adaptive_rate_estimate(self):
+        """Test the arrival-rate estimate tracks a steady stream and sets no hold at light load"""
+        policy = AdaptiveLobbyBatching(time_constant=300.0)
+        policy_state = policy.initial_state()
+        for i in range(3000):
+            policy_state = policy.observe_arrival(policy_state, i * 5.0)
+        self.assertAlmostEqual(policy_state[0], 0.2, delta=0.02)
+
+        simulation = GroupSimulation(num_floors=10, num_cars=3, car_capacity=12)
+        load, max_hold = policy.targets(simulation, policy.observe_arrival(policy.initial_state(), 0.0))
+        self.assertEqual(load, 1.0)
+
+    def test_adaptive_snapshot_continues_like_original(self):
+        """Test a snapshot carries the rate estimate, so its continuation matches the uninterrupted run"""
+        arrivals = TrafficGenerator(10, 0.25, 'up_peak', seed=3).generate(1800)
+        simulation = GroupSimulation(num_floors=10, num_cars=3, car_capacity=12,
+                                     departure_policy=AdaptiveLobbyBatching())
+        reference = simulation.run(arrivals)
+
+        state = simulation.start(arrivals)
+        simulation.advance(state, 900.0)
+        clone = state.snapshot()
+        # Finish the original first; a rate estimate shared with it would skew the clone's holds
+        simulation.advance(state, float('inf'))
+        simulation.start([])  # Another run on the same policy must not reset the clone either
+        simulation.advance(clone, float('inf'))
+        self.assertGreater(reference['stops'], 0)
+        for finished in (state, clone):
+            self.assertEqual(simulation.summarise(finished)['waits'], reference['waits'])
+            self.assertEqual(finished.stops, reference['stops'])
+
+    def test_handling_capacity_interpolates(self):
+        """Test the capacity lies between the bracketing rates"""
+        report = handling_capacity(lambda: GroupSimulation(num_floors=10, num_cars=2, car_capacity=10),
+                                   10, [0.05, 0.4], duration=1800, wait_target=30.0, seeds=2)
+        self.assertEqual(len(report['rows']), 2)
+        self.assertGreater(report['handling_capacity_5min'], 0.05 * 300)
+        self.assertLess(report['handling_capacity_5min'], 0.4 * 300)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,257 @@
+from typing import List, Dict, Optional
+from concurrent.futures import ProcessPoolExecutor
+import glob
+import mmap
+import os
+import statistics
+import time
+from evacuation_simulation import EvacuationSimulation, clearance_time_distribution
+
+NODE_ROOT = "/sys/devices/system/node"
+
+def parse_cpulist(text: str) -> List[int]:
+    """Parse a kernel cpulist such as '0-3,8,10-11'"""
+    cpus = []
+    for part in text.strip().split(','):
+        if not part:
+            continue
+        if '-' in part:
+            first, last = part.split('-')
+            cpus.extend(range(int(first), int(last) + 1))
+        else:
+            cpus.append(int(part))
+    return cpus
+
+def numa_nodes() -> Dict[int, List[int]]:
+    """Map each NUMA node to the CPUs this process may run on"""
+    allowed = set(os.sched_getaffinity(0))
+    nodes = {}
+    for path in sorted(glob.glob(os.path.join(NODE_ROOT, "node[0-9]*"))):
+        node = int(os.path.basename(path)[4:])
+        try:
+            with open(os.path.join(path, "cpulist")) as f:
+                cpus = [cpu for cpu in parse_cpulist(f.read()) if cpu in allowed]
+        except OSError:
+            continue
+        if cpus:
+            nodes[node] = cpus
+
+    if not nodes:
+        # No NUMA information (or not Linux): treat the machine as one node
+        nodes[0] = sorted(allowed)
+    return nodes
+
+def read_numastat() -> Dict[int, Dict[str, int]]:
+    """Read per-node page allocation counters from sysfs"""
+    stats = {}
+    for path in glob.glob(os.path.join(NODE_ROOT, "node[0-9]*", "numastat")):
+        node = int(os.path.basename(os.path.dirname(path))[4:])
+        counters = {}
+        try:
+            with open(path) as f:
+                for line in f:
+                    key, value = line.split()
+                    counters[key] = int(value)
+        except (OSError, ValueError):
+            continue
+        stats[node] = counters
+    return stats
+
+def remote_allocation_ratio(before: Dict[int, Dict[str, int]],
+                            after: Dict[int, Dict[str, int]]) -> Optional[float]:
+    """Fraction of page allocations served from a remote node between two snapshots.
+
+    numastat counts page allocations for the whole system, not memory
+    accesses and not just this process, so this is an upper bound on how
+    many of the shards' pages landed off-node, diluted by anything else the
+    machine allocated meanwhile.
+    """
+    local = remote = 0
+    for node, counters in after.items():
+        previous = before.get(node, {})
+        local += counters.get('local_node', 0) - previous.get('local_node', 0)
+        remote += counters.get('other_node', 0) - previous.get('other_node', 0)
+    if local + remote == 0:
+        return None
+    return remote / (local + remote)
+
+def _pin_worker(cpus: List[int]):
+    """Pool initializer: bind the worker to one node so its allocations are first-touch local"""
+    try:
+        os.sched_setaffinity(0, cpus)
+    except (AttributeError, OSError):
+        pass
+
+def _run_shard(args) -> List[float]:
+    """Worker entry point: run a shard of seeds into a node-local result buffer"""
+    simulation, seeds, population_spread = args
+    buffer = mmap.mmap(-1, max(8, len(seeds) * 8))
+    try:
+        values = memoryview(buffer).cast('d')
+        for i, seed in enumerate(seeds):
+            values[i] = simulation.run(seed, population_spread)['clearance_time']
+        times = values[:len(seeds)].tolist()
+        values.release()
+    finally:
+        buffer.close()
+    return times
+
+def numa_sharded_runs(simulation: EvacuationSimulation, num_runs: int = 1000,
+                      population_spread: float = 0.2, nodes: Optional[List[int]] = None,
+                      base_seed: int = 0) -> dict:
+    """Run randomised evacuations sharded across NUMA nodes.
+
+    Each node gets its own worker pool pinned to that node's CPUs, so every
+    shard's simulation copy and result buffer is first-touched locally.
+    Returns clearance times plus per-node throughput and the system-wide
+    remote allocation ratio observed while the shards ran.
+
+    Huge pages are not offered: a simulation's state is Python objects on the
+    interpreter's heap, which cannot be madvised from here, and the result
+    buffer is a few kilobytes, too small for huge pages to matter.
+    """
+    topology = numa_nodes()
+    if nodes is None:
+        nodes = sorted(topology)
+    nodes = [node for node in nodes if node in topology]
+
+    seeds = list(range(base_seed, base_seed + num_runs))
+    node_seeds = {node: seeds[i::len(nodes)] for i, node in enumerate(nodes)}
+
+    before = read_numastat()
+    start = time.time()
+
+    pools = {}
+    futures = {}
+    finished = {node: start for node in nodes}
+
+    def mark_finished(node):
+        def callback(_future):
+            finished[node] = max(finished[node], time.time())
+        return callback
+
+    try:
+        for node in nodes:
+            cpus = topology[node]
+            pools[node] = ProcessPoolExecutor(max_workers=len(cpus), initializer=_pin_worker, initargs=(cpus,))
+            shards = [node_seeds[node][i::len(cpus) * 4] for i in range(len(cpus) * 4)]
+            futures[node] = [pools[node].submit(_run_shard, (simulation, shard, population_spread))
+                             for shard in shards if shard]
+            for future in futures[node]:
+                future.add_done_callback(mark_finished(node))
+
+        times = []
+        per_node = {}
+        for node in nodes:
+            node_times = []
+            for future in futures[node]:
+                node_times.extend(future.result())
+            node_elapsed = finished[node] - start
+            per_node[node] = {
+                'cpus': len(topology[node]),
+                'runs': len(node_times),
+                'runs_per_second': len(node_times) / max(0.001, node_elapsed)
+            }
+            times.extend(node_times)
+    finally:
+        for pool in pools.values():
+            pool.shutdown()
+
+    elapsed = time.time() - start
+    after = read_numastat()
+
+    return {
+        'clearance_times': times,
+        'mean_clearance_time': statistics.mean(times) if times else 0.0,
+        'elapsed': elapsed,
+        'runs_per_second': len(times) / max(0.001, elapsed),
+        'per_node': per_node,
+        'remote_allocation_ratio': remote_allocation_ratio(before, after)
+    }
+
+def pool_scaling_report(simulation: EvacuationSimulation, max_workers: Optional[int] = None,
+                        num_runs: int = 2000, runs_per_worker: int = 500, step: int = 1) -> dict:
+    """Strong and weak scaling of clearance_time_distribution over 1..max_workers pool workers
+
+    Strong scaling keeps num_runs fixed; weak scaling runs runs_per_worker per
+    worker. Every worker count is measured, or every step'th one (max_workers
+    is always included). One worker runs in-process, so speedups include the
+    pool's own cost. Overhead is the share of wall time beyond the serial
+    per-run cost divided over the workers: pool start-up, pickling,
+    imbalance and contention.
+    """
+    max_workers = max_workers or os.cpu_count() or 1
+    counts = list(range(1, max_workers, step)) + [max_workers]
+
+    def measure(workers: int, runs: int) -> float:
+        start = time.perf_counter()
+        clearance_time_distribution(simulation, num_runs=runs, workers=workers)
+        return time.perf_counter() - start
+
+    report = {}
+    for mode, runs_for in (('strong', lambda n: num_runs), ('weak', lambda n: runs_per_worker * n)):
+        rows = []
+        for workers in counts:
+            runs = runs_for(workers)
+            elapsed = measure(workers, runs)
+            if not rows:
+                base_elapsed, per_run = elapsed, elapsed / runs
+            speedup = base_elapsed / elapsed if mode == 'strong' else workers * base_elapsed / elapsed
+            rows.append({
+                'workers': workers,
+                'runs': runs,
+                'elapsed': elapsed,
+                'speedup': speedup,
+                'efficiency': speedup / workers,
+                'runs_per_second_per_worker': runs / elapsed / workers,
+                'overhead': max(0.0, 1 - per_run * runs / workers / elapsed)
+            })
+        report[mode] = rows
+    return report
+
+def socket_scaling_report(simulation: EvacuationSimulation, runs_per_node: int = 500) -> List[dict]:
+    """Measure throughput as shards are spread over 1..N NUMA nodes (fixed work per node)"""
+    all_nodes = sorted(numa_nodes())
+    report = []
+    baseline = None
+
+    for count in range(1, len(all_nodes) + 1):
+        nodes = all_nodes[:count]
+        result = numa_sharded_runs(simulation, num_runs=runs_per_node * count, nodes=nodes)
+        if baseline is None:
+            baseline = result['runs_per_second']
+        report.append({
+            'nodes': count,
+            'runs_per_second': result['runs_per_second'],
+            'speedup': result['runs_per_second'] / max(1e-9, baseline),
+            'remote_allocation_ratio': result['remote_allocation_ratio']
+        })
+    return report
+
+def demonstrate_numa_sharding():
+    """Demonstrate NUMA-aware sharded evacuation runs"""
+    print("=== NUMA-Aware Sharding Demonstration ===\n")
+
+    topology = numa_nodes()
+    for node, cpus in topology.items():
+        print(f"Node {node}: {len(cpus)} CPUs")
+
+    simulation = EvacuationSimulation(num_floors=10, num_cars=3, car_capacity=12)
+    print(f"\n{'Nodes':<8} {'Runs/s':<12} {'Speedup':<10} {'Remote allocs (system-wide)':<12}")
+    print("-" * 58)
+    for row in socket_scaling_report(simulation, runs_per_node=1000):
+        ratio = row['remote_allocation_ratio']
+        ratio_str = f"{ratio:.3f}" if ratio is not None else "n/a"
+        print(f"{row['nodes']:<8} {row['runs_per_second']:<12.0f} {row['speedup']:<10.2f} {ratio_str:<12}")
+
+    print(f"\nUnpinned pool scaling on {os.cpu_count()} CPUs:")
+    pool_report = pool_scaling_report(simulation, num_runs=2000, runs_per_worker=500)
+    for mode, rows in pool_report.items():
+        print(f"  {mode.capitalize():<7} {'Workers':<9} {'Runs':<7} {'Wall (s)':<10} {'Speedup':<9} "
+              f"{'Efficiency':<12} {'Runs/s/worker':<15} {'Overhead'}")
+        for row in rows:
+            print(f"  {'':<7} {row['workers']:<9} {row['runs']:<7} {row['elapsed']:<10.2f} {row['speedup']:<9.2f} "
+                  f"{row['efficiency']:<12.1%} {row['runs_per_second_per_worker']:<15.0f} {row['overhead']:.1%}")
+
+if __name__ == "__main__":
+    demonstrate_numa_sharding()
@@ -0,0 +1,56 @@
+import unittest
+from evacuation_simulation import EvacuationSimulation, clearance_time_distribution
+from numa_sharding import (parse_cpulist, numa_nodes, remote_allocation_ratio, numa_sharded_runs,
+                           pool_scaling_report, _run_shard)
+
+class TestTopology(unittest.TestCase):
+
+    def test_parse_cpulist(self):
+        """Test kernel cpulist ranges and singletons"""
+        self.assertEqual(parse_cpulist("0-3,8,10-11\n"), [0, 1, 2, 3, 8, 10, 11])
+        self.assertEqual(parse_cpulist(""), [])
+
+    def test_every_node_has_cpus(self):
+        """Test the discovered topology is usable for pinning"""
+        nodes = numa_nodes()
+        self.assertGreater(len(nodes), 0)
+        for cpus in nodes.values():
+            self.assertGreater(len(cpus), 0)
+
+    def test_remote_allocation_ratio(self):
+        """Test remote allocation ratio from numastat snapshots"""
+        before = {0: {'local_node': 100, 'other_node': 10}, 1: {'local_node': 50, 'other_node': 0}}
+        after = {0: {'local_node': 190, 'other_node': 20}, 1: {'local_node': 50, 'other_node': 0}}
+        self.assertAlmostEqual(remote_allocation_ratio(before, after), 10 / 100)
+        self.assertIsNone(remote_allocation_ratio(after, after))
+
+class TestShardedRuns(unittest.TestCase):
+
+    def test_shard_buffer_round_trip(self):
+        """Test a shard returns one clearance time per seed, as the simulation computes it"""
+        simulation = EvacuationSimulation()
+        times = _run_shard((simulation, [1, 2, 3], 0.2))
+        self.assertEqual(times, [simulation.run(seed, 0.2)['clearance_time'] for seed in [1, 2, 3]])
+
+    def test_matches_unsharded_distribution(self):
+        """Test NUMA sharding does not change the simulated results"""
+        simulation = EvacuationSimulation(num_cars=2)
+        result = numa_sharded_runs(simulation, num_runs=40)
+        reference = clearance_time_distribution(simulation, num_runs=40, workers=1)
+
+        self.assertEqual(len(result['clearance_times']), 40)
+        self.assertAlmostEqual(result['mean_clearance_time'], reference['mean'])
+        self.assertEqual(sum(node['runs'] for node in result['per_node'].values()), 40)
+
+    def test_pool_scaling_covers_every_worker_count(self):
+        """Test the scaling report measures each worker count with fixed and per-worker runs"""
+        report = pool_scaling_report(EvacuationSimulation(), max_workers=3, num_runs=12, runs_per_worker=4)
+        self.assertEqual([row['workers'] for row in report['strong']], [1, 2, 3])
+        self.assertEqual([row['runs'] for row in report['strong']], [12, 12, 12])
+        self.assertEqual([row['runs'] for row in report['weak']], [4, 8, 12])
+        self.assertEqual(report['strong'][0]['speedup'], 1.0)
+        stepped = pool_scaling_report(EvacuationSimulation(), max_workers=4, num_runs=8, runs_per_worker=2, step=2)
+        self.assertEqual([row['workers'] for row in stepped['weak']], [1, 3, 4])
+
+if __name__ == "__main__":
+    unittest.main()
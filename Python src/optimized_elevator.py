@@ -1,5 +1,5 @@
 from enum import Enum
-from typing import List, Set
+from typing import List, Optional, Set
 import heapq
 
 class ElevatorState(Enum):
@@ -14,7 +14,8 @@ class Direction(Enum):
     IDLE = -1
 
 class OptimizedElevator:
-    def __init__(self, num_floors: int = 10, starting_floor: int = 1):
+    def __init__(self, num_floors: int = 10, starting_floor: int = 1,
+                 max_calls_per_passenger: int = 3, empty_car_call_limit: int = 1):
         self.num_floors = num_floors
         self.current_floor = starting_floor
         self.state = ElevatorState.IDLE
@@ -23,7 +24,13 @@ class OptimizedElevator:
         # Use sets for O(1) lookup and heaps for efficient scheduling
         self.up_requests = []  # min heap for upward requests
         self.down_requests = []  # max heap (negated) for downward requests
-        self.current_requests = set()  # All active requests
+        self.current_requests = set()  # All active requests; heap entries not in here are stale
+
+        # Nuisance-call filtering, active once a load-weighing reading is available
+        self.load = None  # Passengers in the car, None when unknown
+        self.max_calls_per_passenger = max_calls_per_passenger
+        self.empty_car_call_limit = empty_car_call_limit
+        self.filtered_calls = {"inconsistent_load": 0, "per_passenger": 0, "ghost": 0, "cancelled": 0}
 
     def add_floor_request(self, floor: int) -> bool:
         """Add a floor request with validation"""
@@ -33,6 +40,12 @@ class OptimizedElevator:
         if floor == self.current_floor:
             return True  # Already at requested floor
 
+        if floor in self.current_requests:
+            return True  # Already pending
+
+        if self._is_nuisance_call():
+            return False
+
         self.current_requests.add(floor)
 
         if floor > self.current_floor:
@@ -46,12 +59,51 @@ class OptimizedElevator:
         """Add multiple floor requests"""
         return [self.add_floor_request(floor) for floor in floors]
 
+    def _is_nuisance_call(self) -> bool:
+        """Check a new car call against the car load, counting it if filtered"""
+        if self.load is None:
+            return False
+        if self.load == 0:
+            if len(self.current_requests) >= self.empty_car_call_limit:
+                self.filtered_calls["inconsistent_load"] += 1
+                return True
+            return False
+        if len(self.current_requests) >= self.load * self.max_calls_per_passenger:
+            self.filtered_calls["per_passenger"] += 1
+            return True
+        return False
+
+    def update_load(self, passengers: int):
+        """Record a load-weighing reading; an empty car drops its remaining car calls as ghosts"""
+        self.load = max(0, passengers)
+        if self.load == 0 and self.current_requests:
+            self.filtered_calls["ghost"] += len(self.current_requests)
+            self.current_requests.clear()
+            self.up_requests.clear()
+            self.down_requests.clear()
+
+    def cancel_request(self, floor: int) -> bool:
+        """Cancel a pending call; its heap entry is dropped lazily when reached"""
+        if floor not in self.current_requests:
+            return False
+        self.current_requests.discard(floor)
+        self.filtered_calls["cancelled"] += 1
+        return True
+
     def _is_valid_floor(self, floor: int) -> bool:
         """Validate floor number"""
         return 1 <= floor <= self.num_floors
 
+    def _discard_stale(self):
+        """Pop cancelled or already-served floors off the tops of both heaps"""
+        while self.up_requests and self.up_requests[0] not in self.current_requests:
+            heapq.heappop(self.up_requests)
+        while self.down_requests and -self.down_requests[0] not in self.current_requests:
+            heapq.heappop(self.down_requests)
+
     def _get_next_floor(self) -> int:
         """Get next floor using SCAN algorithm"""
+        self._discard_stale()
         if self.direction == Direction.UP and self.up_requests:
             return heapq.heappop(self.up_requests)
         elif self.direction == Direction.DOWN and self.down_requests:
@@ -110,8 +162,9 @@ class OptimizedElevator:
             "state": self.state.value,
             "direction": self.direction.value,
             "pending_requests": sorted(list(self.current_requests)),
-            "up_queue": sorted(self.up_requests),
-            "down_queue": sorted([-x for x in self.down_requests], reverse=True)
+            "up_queue": sorted(x for x in self.up_requests if x in self.current_requests),
+            "down_queue": sorted([-x for x in self.down_requests if -x in self.current_requests], reverse=True),
+            "filtered_calls": dict(self.filtered_calls)
         }
 
     def clear_requests(self):
@@ -162,5 +215,18 @@ def demonstrate_elevator():
     print("Request results for [1, 5, 3, 0, 2]:", results)
     print("Valid requests processed:", test_elevator.get_status()["pending_requests"])
 
+    # Test nuisance filtering
+    print("\nTest 4: Nuisance-call filtering")
+    for filtering in (False, True):
+        prank_elevator = OptimizedElevator(num_floors=10, starting_floor=1)
+        if filtering:
+            prank_elevator.update_load(1)  # One passenger pressing every button
+        prank_elevator.add_multiple_requests(list(range(2, 11)))
+        prank_elevator.cancel_request(3)
+        movements = prank_elevator.process_requests()
+        stops = len([m for m in movements if "Doors open" in m])
+        print(f"  Filtering {'on ' if filtering else 'off'}: {stops} stops, "
+              f"filtered {prank_elevator.get_status()['filtered_calls']}")
+
 if __name__ == "__main__":
     demonstrate_elevator()
\ No newline at end of file
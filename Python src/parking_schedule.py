@@ -0,0 +1,221 @@
+from typing import Dict, Iterable, List, Optional, Tuple
+from collections import Counter, defaultdict
+from datetime import datetime, timezone
+import time
+
+DAYS_PER_WEEK = 7
+MINUTES_PER_DAY = 24 * 60
+
+def _zone_cost(floors: List[int], weights: List[float], start: int, end: int) -> Tuple[float, int]:
+    """Weighted distance to the weighted median of floors[start:end], and that median"""
+    total = sum(weights[start:end])
+    running = 0.0
+    median = floors[start]
+    for i in range(start, end):
+        running += weights[i]
+        if running >= total / 2:
+            median = floors[i]
+            break
+    cost = sum(w * abs(f - median) for f, w in zip(floors[start:end], weights[start:end]))
+    return cost, median
+
+def optimal_zones(demand: Dict[int, float], num_zones: int) -> List[Tuple[int, int, float]]:
+    """Split floors with demand into contiguous zones minimising weighted distance to each zone's median.
+
+    Exact 1-D k-medians by dynamic programming over the floors that have
+    demand. Returns (parking floor, highest floor of the zone, zone demand)
+    per zone, lowest zone first.
+    """
+    floors = sorted(f for f, w in demand.items() if w > 0)
+    if not floors:
+        return []
+    weights = [demand[f] for f in floors]
+    n = len(floors)
+    k = min(num_zones, n)
+
+    costs = {}
+    for i in range(n):
+        for j in range(i + 1, n + 1):
+            costs[i, j] = _zone_cost(floors, weights, i, j)
+
+    # best[z][j]: minimum cost covering floors[:j] with z zones
+    inf = float('inf')
+    best = [[inf] * (n + 1) for _ in range(k + 1)]
+    split = [[0] * (n + 1) for _ in range(k + 1)]
+    best[0][0] = 0.0
+    for z in range(1, k + 1):
+        for j in range(z, n + 1):
+            for i in range(z - 1, j):
+                candidate = best[z - 1][i] + costs[i, j][0]
+                if candidate < best[z][j]:
+                    best[z][j], split[z][j] = candidate, i
+
+    zones = []
+    j = n
+    for z in range(k, 0, -1):
+        i = split[z][j]
+        zones.append((costs[i, j][1], floors[j - 1], sum(weights[i:j])))
+        j = i
+    return zones[::-1]
+
+def allocate_cars(zone_demand: List[float], num_cars: int) -> List[int]:
+    """Cars per zone in proportion to demand (largest remainder), at least one per zone"""
+    count = len(zone_demand)
+    if count == 0:
+        return []
+    allocation = [1] * count
+    spare = num_cars - count
+    total = sum(zone_demand)
+    if spare <= 0 or total <= 0:
+        return allocation
+
+    shares = [spare * d / total for d in zone_demand]
+    for z in range(count):
+        allocation[z] += int(shares[z])
+    remainders = sorted(range(count), key=lambda z: shares[z] - int(shares[z]), reverse=True)
+    for z in remainders[:num_cars - sum(allocation)]:
+        allocation[z] += 1
+    return allocation
+
+class ParkingSchedule:
+    """Per-weekday, per-time-slot parking table compiled offline from hall-call history.
+
+    Each slot holds one parking floor per car: zones come from exact 1-D
+    k-medians on the slot's call origins, using the most zones (up to
+    num_zones) that each carry at least min_zone_share of the demand, and
+    cars are spread over zones by demand share, so a lobby-dominated
+    up-peak slot parks several cars at the lobby. Entries are
+    stored in a flat ROM-style list indexed by weekday * slots_per_day +
+    slot, so a parking decision at run time is one index computation and
+    one lookup. Weekdays and slots are taken in UTC, so the table does not
+    depend on the host's time zone. Slots without history fall back to the
+    weekday's, then the whole history's, demand.
+    """
+
+    def __init__(self, num_floors: int, num_cars: int, slot_minutes: int = 30, default_floor: int = 1):
+        if MINUTES_PER_DAY % slot_minutes:
+            raise ValueError("slot_minutes must divide a day")
+        self.num_floors = num_floors
+        self.num_cars = num_cars
+        self.slot_minutes = slot_minutes
+        self.slots_per_day = MINUTES_PER_DAY // slot_minutes
+        self.rom = [tuple([default_floor] * num_cars)] * (DAYS_PER_WEEK * self.slots_per_day)
+
+    def slot_index(self, timestamp: float) -> int:
+        dt = datetime.fromtimestamp(timestamp, timezone.utc)
+        return dt.weekday() * self.slots_per_day + (dt.hour * 60 + dt.minute) // self.slot_minutes
+
+    def lookup(self, timestamp: Optional[float] = None) -> Tuple[int, ...]:
+        """Parking floors for every car at a time (lowest floor first)"""
+        return self.rom[self.slot_index(time.time() if timestamp is None else timestamp)]
+
+    def parking_floor(self, car: Optional[int] = None, timestamp: Optional[float] = None) -> int:
+        """Parking floor for one car, or for a car not tied to an index: the zone with the most cars"""
+        floors = self.lookup(timestamp)
+        if car is not None:
+            return floors[car % len(floors)]
+        return Counter(floors).most_common(1)[0][0]
+
+    def _parking_floors(self, demand: Dict[int, float], num_zones: int, min_zone_share: float) -> Tuple[int, ...]:
+        total = sum(demand.values())
+        for count in range(num_zones, 0, -1):
+            zones = optimal_zones(demand, count)
+            if all(zone[2] >= min_zone_share * total for zone in zones):
+                break
+        allocation = allocate_cars([zone[2] for zone in zones], self.num_cars)
+        floors = []
+        for (parking_floor, _, _), cars in zip(zones, allocation):
+            floors.extend([parking_floor] * cars)
+        return tuple(floors)
+
+    @classmethod
+    def compile(cls, history: Iterable[Tuple[float, int]], num_floors: int, num_cars: int,
+                slot_minutes: int = 30, num_zones: Optional[int] = None,
+                min_zone_share: Optional[float] = None) -> 'ParkingSchedule':
+        """Build the table from (timestamp, call origin floor) history"""
+        schedule = cls(num_floors, num_cars, slot_minutes)
+        num_zones = num_cars if num_zones is None else min(num_zones, num_cars)  # One car per zone at most
+        min_zone_share = 1 / (2 * num_cars) if min_zone_share is None else min_zone_share
+
+        per_slot = defaultdict(lambda: defaultdict(float))
+        per_day = defaultdict(lambda: defaultdict(float))
+        overall = defaultdict(float)
+        for timestamp, origin in history:
+            index = schedule.slot_index(timestamp)
+            per_slot[index][origin] += 1
+            per_day[index // schedule.slots_per_day][origin] += 1
+            overall[origin] += 1
+
+        rom = []
+        for index in range(DAYS_PER_WEEK * schedule.slots_per_day):
+            demand = per_slot.get(index) or per_day.get(index // schedule.slots_per_day) or overall
+            rom.append(schedule._parking_floors(demand, num_zones, min_zone_share) if demand else schedule.rom[index])
+        schedule.rom = rom
+        return schedule
+
+    @classmethod
+    def from_cache(cls, cache, num_floors: int, num_cars: int = 1, slot_minutes: int = 30) -> 'ParkingSchedule':
+        """Compile from the request history kept by an ElevatorCache"""
+        history = [(entry['timestamp'], entry['from']) for entry in cache.recent_requests]
+        return cls.compile(history, num_floors, num_cars, slot_minutes)
+
+    def to_c_array(self, name: str = 'PARKING_ROM') -> str:
+        """C initializer for a synthesis-friendly ROM: [weekday * slots + slot][car]"""
+        rows = ",\n".join("    {" + ", ".join(str(f) for f in entry) + "}" for entry in self.rom)
+        return (f"// Generated by parking_schedule.py: {DAYS_PER_WEEK} days x {self.slots_per_day} slots "
+                f"of {self.slot_minutes} min, {self.num_cars} cars\n"
+                f"const unsigned char {name}[{len(self.rom)}][{self.num_cars}] = {{\n{rows}\n}};\n")
+
+def mean_call_distance(schedule: ParkingSchedule, calls: Iterable[Tuple[float, int]]) -> float:
+    """Mean floors from the nearest scheduled parking floor to each call origin"""
+    distances = [min(abs(origin - floor) for floor in schedule.lookup(timestamp)) for timestamp, origin in calls]
+    return sum(distances) / len(distances) if distances else 0.0
+
+def synthetic_history(num_floors: int, weeks: int, start: float, seed: int = 0) -> List[Tuple[float, int]]:
+    """Office-building call origins: weekday peaks on the office day profile, quiet weekends"""
+    from adaptive_fidelity import day_profile
+    history = []
+    for day in range(weeks * DAYS_PER_WEEK):
+        day_start = start + day * 86400
+        weekday = datetime.fromtimestamp(day_start, timezone.utc).weekday()
+        if weekday < 5:
+            arrivals = day_profile(num_floors, seed=f"{seed}:{day}")
+        else:
+            arrivals = day_profile(num_floors, segments=[(24, 0.003, 'interfloor')], seed=f"{seed}:{day}")
+        history.extend((day_start + t, origin) for t, origin, _ in arrivals)
+    return history
+
+def demonstrate_parking_schedule():
+    """Compile a parking table from a synthetic history and evaluate it on a held-out week"""
+    print("=== Time-Table Parking Schedule Demonstration ===\n")
+
+    num_floors, num_cars = 16, 3
+    monday = datetime(2024, 1, 1, tzinfo=timezone.utc).timestamp()
+    history = synthetic_history(num_floors, weeks=4, start=monday, seed=1)
+    held_out = synthetic_history(num_floors, weeks=1, start=monday + 4 * 7 * 86400, seed=2)
+
+    start = time.time()
+    schedule = ParkingSchedule.compile(history, num_floors, num_cars, slot_minutes=30)
+    print(f"Compiled {len(schedule.rom)} slots from {len(history)} calls in {time.time() - start:.2f}s")
+
+    for label, hour in (("Mon 03:00", 3), ("Mon 08:00", 8), ("Mon 12:30", 12.5), ("Mon 17:30", 17.5)):
+        print(f"  {label}: park at floors {schedule.lookup(monday + hour * 3600)}")
+    print(f"  Sat 12:00: park at floors {schedule.lookup(monday + 5 * 86400 + 12 * 3600)}")
+
+    # Static baseline: one all-week table entry (what a single learned idle position gives)
+    static = ParkingSchedule.compile([(monday, origin) for _, origin in history], num_floors, num_cars,
+                                     slot_minutes=MINUTES_PER_DAY)
+    static.rom = [static.rom[0]] * len(static.rom)
+
+    print(f"\nHeld-out week, mean floors from nearest parked car to the call:")
+    print(f"  time-table schedule: {mean_call_distance(schedule, held_out):.2f}")
+    print(f"  static parking {static.rom[0]}: {mean_call_distance(static, held_out):.2f}")
+
+    lookups = 100000
+    start = time.time()
+    for i in range(lookups):
+        schedule.rom[i % len(schedule.rom)]
+    print(f"\nROM lookup: {(time.time() - start) * 1e9 / lookups:.0f} ns")
+
+if __name__ == "__main__":
+    demonstrate_parking_schedule()
@@ -0,0 +1,123 @@
+import unittest
+import os
+import time
+from datetime import datetime, timezone
+from cached_elevator import CachedElevator, ElevatorCache, ElevatorState
+from parking_schedule import ParkingSchedule, optimal_zones, allocate_cars, mean_call_distance
+
+MONDAY = datetime(2024, 1, 1, tzinfo=timezone.utc).timestamp()
+HOUR = 3600
+
+class TestParkingSchedule(unittest.TestCase):
+
+    def test_optimal_zones_splits_clusters(self):
+        """Test k-medians parks one car at the median of each demand cluster"""
+        demand = {1: 10, 2: 5, 9: 3, 10: 6, 11: 3}
+        zones = optimal_zones(demand, 2)
+        self.assertEqual([zone[0] for zone in zones], [1, 10])
+        self.assertEqual([zone[1] for zone in zones], [2, 11])
+        self.assertEqual([zone[2] for zone in zones], [15, 12])
+
+    def test_allocate_cars(self):
+        """Test cars follow demand share with at least one car per zone"""
+        self.assertEqual(allocate_cars([90, 10], 4), [3, 1])
+        self.assertEqual(allocate_cars([1, 1, 1], 3), [1, 1, 1])
+        self.assertEqual(sum(allocate_cars([5, 3, 2], 7)), 7)
+
+    def test_lookup_by_weekday_and_slot(self):
+        """Test each slot gets its own parking floors"""
+        history = ([(MONDAY + 8 * HOUR + 60 * i, 1) for i in range(20)] +
+                   [(MONDAY + 17 * HOUR + 60 * i, 12) for i in range(20)])
+        schedule = ParkingSchedule.compile(history, num_floors=12, num_cars=2, slot_minutes=60)
+        self.assertEqual(schedule.lookup(MONDAY + 8 * HOUR + 600), (1, 1))
+        self.assertEqual(schedule.lookup(MONDAY + 17 * HOUR + 600), (12, 12))
+
+    def test_lobby_dominated_slot_stacks_cars(self):
+        """Test a thin secondary zone is merged so spare cars wait at the lobby"""
+        history = [(MONDAY + 8 * HOUR + i, 1) for i in range(95)] + [(MONDAY + 8 * HOUR + i, 10) for i in range(5)]
+        schedule = ParkingSchedule.compile(history, num_floors=10, num_cars=3)
+        self.assertEqual(schedule.lookup(MONDAY + 8 * HOUR), (1, 1, 1))
+
+    def test_empty_slots_fall_back(self):
+        """Test slots without history use the weekday's, then the overall, demand"""
+        history = [(MONDAY + 9 * HOUR, 6)] * 10
+        schedule = ParkingSchedule.compile(history, num_floors=10, num_cars=1)
+        self.assertEqual(schedule.lookup(MONDAY + 2 * HOUR), (6,))
+        self.assertEqual(schedule.lookup(MONDAY + 3 * 24 * HOUR), (6,))
+
+    def test_c_array_shape(self):
+        """Test the generated ROM initializer has one row per slot"""
+        schedule = ParkingSchedule(num_floors=10, num_cars=2, slot_minutes=60)
+        source = schedule.to_c_array('ROM')
+        self.assertIn("const unsigned char ROM[168][2]", source)
+        self.assertEqual(source.count("{1, 1}"), 168)
+
+    def test_more_zones_than_cars(self):
+        """Test zones are capped at the car count so every ROM row has one entry per car"""
+        history = [(MONDAY + 8 * HOUR + i, floor) for i in range(20) for floor in (1, 4, 7, 10)]
+        schedule = ParkingSchedule.compile(history, num_floors=10, num_cars=2, slot_minutes=60, num_zones=4)
+        self.assertTrue(all(len(entry) == 2 for entry in schedule.rom))
+        self.assertIn("const unsigned char PARKING_ROM[168][2]", schedule.to_c_array())
+
+    def test_invalid_slot_length(self):
+        """Test slot lengths must divide a day"""
+        with self.assertRaises(ValueError):
+            ParkingSchedule(10, 1, slot_minutes=7)
+
+    def test_slots_are_utc(self):
+        """Test slot lookup does not depend on the host's time zone"""
+        schedule = ParkingSchedule(num_floors=10, num_cars=1, slot_minutes=60)
+        saved = os.environ.get('TZ')
+        try:
+            for zone in ('UTC', 'America/New_York', 'Asia/Kolkata'):
+                os.environ['TZ'] = zone
+                time.tzset()
+                self.assertEqual(schedule.slot_index(MONDAY + 8 * HOUR + 600), 8)
+        finally:
+            if saved is None:
+                del os.environ['TZ']
+            else:
+                os.environ['TZ'] = saved
+            time.tzset()
+
+    def test_parking_floor_per_car(self):
+        """Test a car takes its own entry, or the zone with the most cars when unindexed"""
+        schedule = ParkingSchedule(num_floors=10, num_cars=3)
+        schedule.rom = [(1, 9, 9)] * len(schedule.rom)
+        self.assertEqual(schedule.parking_floor(0, MONDAY), 1)
+        self.assertEqual(schedule.parking_floor(2, MONDAY), 9)
+        self.assertEqual(schedule.parking_floor(None, MONDAY), 9)
+
+    def test_mean_call_distance(self):
+        """Test the distance metric against a hand-computed case"""
+        schedule = ParkingSchedule(num_floors=10, num_cars=2)
+        schedule.rom = [(1, 8)] * len(schedule.rom)
+        self.assertEqual(mean_call_distance(schedule, [(MONDAY, 1), (MONDAY, 5), (MONDAY, 10)]), 5 / 3)
+
+    def test_cached_elevator_uses_schedule(self):
+        """Test pre-positioning follows the compiled schedule instead of the learned idle position"""
+        cache = ElevatorCache()
+        now = time.time()
+        for i in range(10):
+            cache.record_request(7, 2, timestamp=now - i)
+        schedule = ParkingSchedule.from_cache(cache, num_floors=10)
+        self.assertEqual(schedule.lookup(now), (7,))
+
+        elevator = CachedElevator(num_floors=10, parking_schedule=schedule)
+        elevator.last_request_time = time.time() - 35
+        elevator._pre_position()
+        self.assertEqual(elevator.current_floor, 7)
+        self.assertEqual(elevator.state, ElevatorState.PRE_POSITIONED)
+
+    def test_cached_elevator_takes_its_own_zone(self):
+        """Test an indexed car pre-positions to its entry rather than the lowest zone"""
+        schedule = ParkingSchedule(num_floors=10, num_cars=2)
+        schedule.rom = [(2, 8)] * len(schedule.rom)
+        elevator = CachedElevator(num_floors=10, parking_schedule=schedule, car_index=1)
+        elevator.cache.record_request(3, 5)
+        elevator.last_request_time = time.time() - 35
+        elevator._pre_position()
+        self.assertEqual(elevator.current_floor, 8)
+
+if __name__ == '__main__':
+    unittest.main()
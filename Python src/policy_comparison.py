@@ -0,0 +1,126 @@
+from typing import Callable, List
+import math
+import statistics
+import time
+from traffic_simulation import TrafficGenerator, GroupSimulation
+
+# Each policy maps an arrival stream to a scalar metric (e.g. mean wait)
+Policy = Callable[[list], float]
+
+METHODS = ('independent', 'crn', 'antithetic', 'control_variate')
+
+class PolicyComparison:
+    """Estimate the difference in a metric between two policies to a requested precision.
+
+    Methods, from least to most variance reduction:
+      independent     - each policy sees its own traffic
+      crn             - both policies see the same traffic (common random numbers)
+      antithetic      - CRN on antithetic pairs of streams, averaged per pair
+      control_variate - antithetic CRN adjusted by the arrival count, whose
+                        expectation (rate x duration) is known exactly
+    """
+
+    def __init__(self, policy_a: Policy, policy_b: Policy, num_floors: int = 10,
+                 arrival_rate: float = 0.15, pattern: str = 'up_peak', duration: float = 1800,
+                 base_seed: int = 0):
+        self.policy_a = policy_a
+        self.policy_b = policy_b
+        self.num_floors = num_floors
+        self.arrival_rate = arrival_rate
+        self.pattern = pattern
+        self.duration = duration
+        self.base_seed = base_seed
+
+    def _arrivals(self, seed: int, antithetic: bool = False) -> list:
+        return TrafficGenerator(self.num_floors, self.arrival_rate, self.pattern,
+                                seed=seed, antithetic=antithetic).generate(self.duration)
+
+    def _observation(self, method: str, replication: int) -> tuple:
+        """One (difference, control) observation for a replication"""
+        seed = self.base_seed + replication
+
+        if method == 'independent':
+            # Distinct seeds for the two policies
+            arrivals_a = self._arrivals(2 * seed)
+            arrivals_b = self._arrivals(2 * seed + 1)
+            return self.policy_a(arrivals_a) - self.policy_b(arrivals_b), len(arrivals_a)
+
+        if method == 'crn':
+            arrivals = self._arrivals(seed)
+            return self.policy_a(arrivals) - self.policy_b(arrivals), len(arrivals)
+
+        forward = self._arrivals(seed)
+        mirrored = self._arrivals(seed, antithetic=True)
+        difference = 0.5 * ((self.policy_a(forward) - self.policy_b(forward)) +
+                            (self.policy_a(mirrored) - self.policy_b(mirrored)))
+        return difference, 0.5 * (len(forward) + len(mirrored))
+
+    def _estimate(self, method: str, differences: List[float], controls: List[float]) -> tuple:
+        """Point estimate and sample variance of the (possibly control-adjusted) differences"""
+        if method == 'control_variate' and len(differences) > 2:
+            expected = self.arrival_rate * self.duration
+            mean_c = statistics.mean(controls)
+            var_c = statistics.variance(controls)
+            if var_c > 0:
+                mean_d = statistics.mean(differences)
+                cov = sum((d - mean_d) * (c - mean_c) for d, c in zip(differences, controls)) / (len(controls) - 1)
+                beta = cov / var_c
+                differences = [d - beta * (c - expected) for d, c in zip(differences, controls)]
+        return statistics.mean(differences), statistics.variance(differences)
+
+    def run(self, method: str = 'control_variate', half_width: float = 0.5, confidence_z: float = 1.96,
+            min_replications: int = 5, max_replications: int = 500) -> dict:
+        """Replicate until the confidence interval on (A - B) is narrower than +/- half_width"""
+        if method not in METHODS:
+            raise ValueError(f"Unknown comparison method: {method}")
+
+        start = time.time()
+        differences, controls = [], []
+        mean = variance = 0.0
+        simulations = 0
+
+        for replication in range(max_replications):
+            difference, control = self._observation(method, replication)
+            differences.append(difference)
+            controls.append(control)
+            simulations += 2 if method in ('independent', 'crn') else 4
+
+            if len(differences) >= max(2, min_replications):
+                mean, variance = self._estimate(method, differences, controls)
+                if confidence_z * math.sqrt(variance / len(differences)) <= half_width:
+                    break
+
+        if len(differences) < 2:
+            mean, variance = differences[0], 0.0
+
+        return {
+            'method': method,
+            'difference': mean,
+            'half_width': confidence_z * math.sqrt(variance / len(differences)),
+            'replications': len(differences),
+            'simulations': simulations,
+            'elapsed': time.time() - start
+        }
+
+def group_policy(num_floors: int, num_cars: int, car_capacity: int, metric: str = 'mean_wait') -> Policy:
+    """Wrap a GroupSimulation configuration as a comparison policy"""
+    simulation = GroupSimulation(num_floors, num_cars, car_capacity)
+    return lambda arrivals: simulation.run(arrivals)[metric]
+
+def demonstrate_policy_comparison():
+    """Compare two bank configurations with and without variance reduction"""
+    print("=== Policy Comparison Demonstration ===\n")
+    print("Mean wait difference: 2 cars vs 3 cars (capacity 12), target +/-0.3s at 95%\n")
+
+    comparison = PolicyComparison(group_policy(10, 2, 12), group_policy(10, 3, 12),
+                                  num_floors=10, arrival_rate=0.12, duration=1800)
+
+    print(f"{'Method':<17} {'Difference':<12} {'+/-':<8} {'Replications':<14} {'Simulations':<12} {'Time (s)'}")
+    print("-" * 75)
+    for method in METHODS:
+        result = comparison.run(method, half_width=0.3, min_replications=10)
+        print(f"{method:<17} {result['difference']:<12.3f} {result['half_width']:<8.3f} "
+              f"{result['replications']:<14} {result['simulations']:<12} {result['elapsed']:.2f}")
+
+if __name__ == "__main__":
+    demonstrate_policy_comparison()
@@ -0,0 +1,73 @@
+import unittest
+from traffic_simulation import TrafficGenerator
+from policy_comparison import PolicyComparison, group_policy, METHODS
+
+class TestVarianceReductionStreams(unittest.TestCase):
+
+    def test_common_random_numbers(self):
+        """Test the same seed gives identical traffic regardless of who consumes it"""
+        first = TrafficGenerator(arrival_rate=0.2, pattern='mixed', seed=11).generate(900)
+        second = TrafficGenerator(arrival_rate=0.2, pattern='mixed', seed=11).generate(900)
+        self.assertEqual(first, second)
+
+    def test_antithetic_stream_is_mirrored(self):
+        """Test antithetic streams differ but keep the same arrival rate"""
+        forward = TrafficGenerator(arrival_rate=0.2, seed=3).generate(20000)
+        mirrored = TrafficGenerator(arrival_rate=0.2, seed=3, antithetic=True).generate(20000)
+        self.assertNotEqual(forward[:10], mirrored[:10])
+        self.assertAlmostEqual(len(mirrored) / 20000, 0.2, delta=0.02)
+
+    def test_antithetic_destinations_negatively_correlated(self):
+        """Test mirrored destinations move in opposite directions"""
+        forward = TrafficGenerator(num_floors=10, arrival_rate=1.0, seed=5)
+        mirrored = TrafficGenerator(num_floors=10, arrival_rate=1.0, seed=5, antithetic=True)
+        pairs = [(forward._trip()[1], mirrored._trip()[1]) for _ in range(2000)]
+        mean_sum = sum(a + b for a, b in pairs) / len(pairs)
+        # Destinations 2..10 mirror around 6, so each pair sums to 12
+        self.assertAlmostEqual(mean_sum, 12.0)
+
+    def test_antithetic_mixed_streams_stay_in_step(self):
+        """Test mixed-pattern partners consume the same number of uniforms per arrival"""
+        forward = TrafficGenerator(num_floors=10, arrival_rate=1.0, pattern='mixed', seed=7)
+        mirrored = TrafficGenerator(num_floors=10, arrival_rate=1.0, pattern='mixed', seed=7, antithetic=True)
+        for _ in range(500):
+            forward._trip()
+            mirrored._trip()
+            self.assertEqual(forward.trip_rng.getstate(), mirrored.trip_rng.getstate())
+
+class TestPolicyComparison(unittest.TestCase):
+
+    def test_identical_policies(self):
+        """Test CRN gives exactly zero difference for identical policies"""
+        policy = group_policy(8, 2, 10)
+        comparison = PolicyComparison(policy, policy, num_floors=8, arrival_rate=0.1, duration=600)
+        result = comparison.run('crn', half_width=0.1)
+        self.assertEqual(result['difference'], 0.0)
+        self.assertEqual(result['replications'], 5)
+
+    def test_control_variate_removes_explained_variance(self):
+        """Test a difference driven only by the arrival count is resolved immediately"""
+        comparison = PolicyComparison(lambda arrivals: 0.1 * len(arrivals), lambda arrivals: 0.0,
+                                      arrival_rate=0.2, duration=1000)
+        plain = comparison.run('antithetic', half_width=0.05, max_replications=50)
+        adjusted = comparison.run('control_variate', half_width=0.05, max_replications=50)
+
+        self.assertLess(adjusted['replications'], plain['replications'])
+        self.assertAlmostEqual(adjusted['difference'], 0.1 * 0.2 * 1000, places=6)
+
+    def test_methods_agree(self):
+        """Test every method estimates a difference of the same sign"""
+        comparison = PolicyComparison(group_policy(10, 2, 12), group_policy(10, 3, 12),
+                                      arrival_rate=0.12, duration=1200)
+        for method in METHODS:
+            result = comparison.run(method, half_width=1.0, max_replications=40)
+            self.assertGreater(result['difference'], 0, method)
+
+    def test_unknown_method(self):
+        """Test unknown comparison methods are rejected"""
+        comparison = PolicyComparison(lambda a: 0.0, lambda a: 0.0)
+        with self.assertRaises(ValueError):
+            comparison.run('bootstrap')
+
+if __name__ == "__main__":
+    unittest.main()
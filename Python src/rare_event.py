@@ -0,0 +1,127 @@
+from typing import List, Optional
+import math
+import random
+import time
+from traffic_simulation import TrafficGenerator, GroupSimulation, GroupState
+
+class WaitTailEstimator:
+    """Estimate P(some passenger waits longer than a threshold within a horizon).
+
+    Plain Monte Carlo needs roughly 100/p runs to see a probability p with
+    useful precision. Multilevel splitting instead splits the threshold into
+    intermediate levels on the age of the longest-waiting passenger: each
+    stage runs a fixed number of trajectories until they cross the next
+    level (or hit the horizon), then clones the survivors from snapshots of
+    their reentrant state with reseeded future traffic. The estimate is the
+    product of the per-stage crossing fractions.
+    """
+
+    def __init__(self, simulation: GroupSimulation, arrival_rate: float = 0.1,
+                 pattern: str = 'up_peak', horizon: float = 900, base_seed: int = 0):
+        self.simulation = simulation
+        self.arrival_rate = arrival_rate
+        self.pattern = pattern
+        self.horizon = horizon
+        self.base_seed = base_seed
+        self.steps = 0  # Simulation events processed, the cost measure for both methods
+
+    def _start(self, seed: int) -> GroupState:
+        generator = TrafficGenerator(self.simulation.num_floors, self.arrival_rate, self.pattern, seed=seed)
+        return self.simulation.start(generator, self.horizon)
+
+    def _run_until(self, state: GroupState, level: float) -> bool:
+        """Advance until some passenger has waited `level` seconds; False if the horizon comes first"""
+        checked = len(state.waits)
+        while self.simulation.step(state, self.horizon):
+            self.steps += 1
+            if any(wait >= level for wait in state.waits[checked:]):
+                return True
+            checked = len(state.waits)
+            if state.oldest_wait() >= level:
+                return True
+        # No event left before the horizon: passengers may still have aged past the level
+        return state.oldest_wait(at=self.horizon) >= level
+
+    def monte_carlo(self, threshold: float, runs: int = 1000, max_steps: Optional[int] = None) -> dict:
+        """Crude Monte Carlo estimate, optionally stopped at an event budget for comparison"""
+        self.steps = 0
+        start = time.time()
+        hits = completed = 0
+        for i in range(runs):
+            if max_steps is not None and self.steps >= max_steps:
+                break
+            hits += self._run_until(self._start(self.base_seed + i), threshold)
+            completed += 1
+
+        p = hits / max(1, completed)
+        return {
+            'probability': p,
+            'relative_error': math.sqrt((1 - p) / (p * completed)) if hits else float('inf'),
+            'runs': completed,
+            'steps': self.steps,
+            'elapsed': time.time() - start
+        }
+
+    def splitting(self, trajectories: int, levels: List[float]) -> dict:
+        """Fixed-effort multilevel splitting over increasing wait levels (last = threshold)"""
+        self.steps = 0
+        start = time.time()
+        rng = random.Random(self.base_seed)
+        next_seed = self.base_seed + 1_000_000
+
+        states = [self._start(self.base_seed + i) for i in range(trajectories)]
+        probability = 1.0
+        stage_fractions = []
+        relative_variance = 0.0
+
+        for index, level in enumerate(levels):
+            survivors = [state for state in states if self._run_until(state, level)]
+            fraction = len(survivors) / len(states)
+            stage_fractions.append(fraction)
+            probability *= fraction
+            if not survivors:
+                break
+            relative_variance += (1 - fraction) / (fraction * len(states))
+
+            if index + 1 < len(levels):
+                states = []
+                for _ in range(trajectories):
+                    parent = survivors[rng.randrange(len(survivors))]
+                    states.append(parent.snapshot(reseed=next_seed))
+                    next_seed += 1
+
+        return {
+            'probability': probability,
+            'relative_error': math.sqrt(relative_variance) if probability > 0 else float('inf'),
+            'stage_fractions': stage_fractions,
+            'trajectories': trajectories,
+            'steps': self.steps,
+            'elapsed': time.time() - start
+        }
+
+    def estimate(self, threshold: float, trajectories: int = 200, num_levels: int = 4,
+                 levels: Optional[List[float]] = None) -> dict:
+        """Splitting estimate with evenly spaced levels up to the threshold"""
+        if levels is None:
+            levels = [threshold * (i + 1) / num_levels for i in range(num_levels)]
+        return self.splitting(trajectories, levels)
+
+def demonstrate_rare_event_estimation():
+    """Compare splitting with plain Monte Carlo on a long-wait tail probability"""
+    print("=== Rare-Event Wait Estimation Demonstration ===\n")
+
+    simulation = GroupSimulation(num_floors=10, num_cars=3, car_capacity=12)
+    estimator = WaitTailEstimator(simulation, arrival_rate=0.14, pattern='mixed', horizon=600)
+
+    for threshold in (60.0, 90.0):
+        split = estimator.estimate(threshold, trajectories=300, num_levels=10)
+        print(f"P(wait > {threshold:.0f}s within 10 min), splitting: {split['probability']:.2e} "
+              f"(rel. error {split['relative_error']:.2f}, {split['steps']:,} events, {split['elapsed']:.1f}s)")
+        print(f"  stage fractions: {', '.join(f'{f:.2f}' for f in split['stage_fractions'])}")
+
+        crude = estimator.monte_carlo(threshold, runs=100000, max_steps=split['steps'])
+        print(f"  plain Monte Carlo, same event budget ({crude['runs']} runs): {crude['probability']:.2e} "
+              f"(rel. error {crude['relative_error']:.2f})\n")
+
+if __name__ == "__main__":
+    demonstrate_rare_event_estimation()
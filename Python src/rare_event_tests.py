@@ -0,0 +1,81 @@
+import unittest
+from traffic_simulation import TrafficGenerator, GroupSimulation
+from rare_event import WaitTailEstimator
+
+class TestStateSnapshots(unittest.TestCase):
+
+    def setUp(self):
+        self.simulation = GroupSimulation(num_floors=8, num_cars=2, car_capacity=8)
+
+    def _advance(self, state, until):
+        while state.now < until and self.simulation.step(state, 600):
+            pass
+
+    def test_snapshot_replays_identically(self):
+        """Test a snapshot without reseeding continues exactly like the original"""
+        state = self.simulation.start(TrafficGenerator(8, 0.2, 'mixed', seed=4), 600)
+        self._advance(state, 200)
+
+        clone = state.snapshot()
+        self._advance(state, 600)
+        self._advance(clone, 600)
+        self.assertEqual(state.waits, clone.waits)
+
+    def test_snapshot_is_independent(self):
+        """Test advancing a clone leaves the original untouched"""
+        state = self.simulation.start(TrafficGenerator(8, 0.2, 'mixed', seed=4), 600)
+        self._advance(state, 200)
+        served = len(state.waits)
+
+        clone = state.snapshot(reseed=99)
+        self._advance(clone, 600)
+        self.assertEqual(len(state.waits), served)
+        self.assertGreater(len(clone.waits), served)
+
+    def test_reseeded_clones_diverge(self):
+        """Test reseeded clones see different future traffic"""
+        state = self.simulation.start(TrafficGenerator(8, 0.2, 'mixed', seed=4), 600)
+        self._advance(state, 200)
+
+        first = state.snapshot(reseed=1)
+        second = state.snapshot(reseed=2)
+        self._advance(first, 600)
+        self._advance(second, 600)
+        self.assertNotEqual(first.waits, second.waits)
+
+    def test_run_matches_list_replay(self):
+        """Test lazily generated arrivals match the pre-generated list"""
+        arrivals = TrafficGenerator(8, 0.2, 'mixed', seed=6).generate(600)
+        from_list = self.simulation.run(arrivals)
+        lazy = self.simulation.run(TrafficGenerator(8, 0.2, 'mixed', seed=6), duration=600)
+        self.assertEqual(from_list['passengers_served'], len(arrivals))
+        self.assertEqual(from_list['waits'][:50], lazy['waits'][:50])
+
+class TestWaitTailEstimator(unittest.TestCase):
+
+    def setUp(self):
+        simulation = GroupSimulation(num_floors=8, num_cars=2, car_capacity=8)
+        self.estimator = WaitTailEstimator(simulation, arrival_rate=0.1, pattern='mixed', horizon=300)
+
+    def test_single_level_equals_monte_carlo(self):
+        """Test one-level splitting reduces to plain Monte Carlo on the same seeds"""
+        split = self.estimator.splitting(60, [30.0])
+        crude = self.estimator.monte_carlo(30.0, runs=60)
+        self.assertAlmostEqual(split['probability'], crude['probability'])
+
+    def test_splitting_agrees_with_monte_carlo(self):
+        """Test splitting and Monte Carlo agree on a moderately rare threshold"""
+        split = self.estimator.estimate(45.0, trajectories=150, num_levels=3)
+        crude = self.estimator.monte_carlo(45.0, runs=400)
+        self.assertGreater(split['probability'], 0)
+        self.assertLess(abs(split['probability'] - crude['probability']),
+                        4 * max(split['relative_error'], crude['relative_error']) * crude['probability'])
+
+    def test_probability_decreases_with_threshold(self):
+        """Test longer waits are estimated to be rarer"""
+        low = self.estimator.estimate(20.0, trajectories=100, num_levels=2)
+        high = self.estimator.estimate(50.0, trajectories=100, num_levels=4)
+        self.assertLess(high['probability'], low['probability'])
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,138 @@
+from typing import List, Optional
+import math
+import statistics
+from traffic_simulation import TrafficGenerator, GroupSimulation
+
+def mser_truncation(series: List[float], batch_size: int = 5) -> int:
+    """MSER-m warm-up detection: number of leading observations to discard.
+
+    Observations are grouped into batch means of `batch_size` (MSER-5 by
+    default) and the truncation point d minimises the marginal standard
+    error sum((Y_i - mean_d)^2) / (n - d)^2 over the retained batches.
+    Only the first half of the series is considered, as is customary.
+    """
+    batches = [statistics.mean(series[i:i + batch_size])
+               for i in range(0, len(series) - batch_size + 1, batch_size)]
+    n = len(batches)
+    if n < 4:
+        return 0
+
+    # Suffix sums make each candidate truncation O(1)
+    suffix_sum = [0.0] * (n + 1)
+    suffix_sq = [0.0] * (n + 1)
+    for i in range(n - 1, -1, -1):
+        suffix_sum[i] = suffix_sum[i + 1] + batches[i]
+        suffix_sq[i] = suffix_sq[i + 1] + batches[i] * batches[i]
+
+    best_d, best_score = 0, float('inf')
+    for d in range(n // 2 + 1):
+        kept = n - d
+        mean = suffix_sum[d] / kept
+        score = (suffix_sq[d] - kept * mean * mean) / (kept * kept)
+        if score < best_score:
+            best_d, best_score = d, score
+    return best_d * batch_size
+
+def t_critical(dof: int, z: float = 1.959964) -> float:
+    """Student t quantile via the Cornish-Fisher expansion of the normal quantile (95% by default)"""
+    if dof <= 0:
+        return float('inf')
+    return (z + (z ** 3 + z) / (4 * dof) + (5 * z ** 5 + 16 * z ** 3 + 3 * z) / (96 * dof ** 2) +
+            (3 * z ** 7 + 19 * z ** 5 + 17 * z ** 3 - 15 * z) / (384 * dof ** 3))
+
+def batch_means_interval(series: List[float], num_batches: int = 20) -> tuple:
+    """Mean and confidence half-width of a correlated series by non-overlapping batch means"""
+    size = len(series) // num_batches
+    if size == 0:
+        return (statistics.mean(series) if series else 0.0), float('inf')
+    means = [statistics.mean(series[i * size:(i + 1) * size]) for i in range(num_batches)]
+    half_width = t_critical(num_batches - 1) * statistics.stdev(means) / math.sqrt(num_batches)
+    return statistics.mean(means), half_width
+
+class SequentialRun:
+    """Simulate in chunks until the post-warm-up confidence interval is narrow enough.
+
+    After each chunk of simulated time, MSER-5 picks the warm-up truncation
+    on the wait series, and batch means give a confidence interval on the
+    mean wait of what remains. The run stops as soon as the half-width is
+    within `half_width` seconds (or `relative` x mean), so easy
+    configurations finish early and hard ones keep going up to `max_time`.
+    """
+
+    def __init__(self, simulation: GroupSimulation, arrival_rate: float = 0.1, pattern: str = 'up_peak',
+                 seed: int = 0, chunk: float = 600, max_time: float = 24 * 3600,
+                 half_width: Optional[float] = None, relative: Optional[float] = 0.05,
+                 num_batches: int = 20):
+        self.simulation = simulation
+        self.arrival_rate = arrival_rate
+        self.pattern = pattern
+        self.seed = seed
+        self.chunk = chunk
+        self.max_time = max_time
+        self.half_width = half_width
+        self.relative = relative
+        self.num_batches = num_batches
+
+    def _precise_enough(self, mean: float, half_width: float) -> bool:
+        if self.half_width is not None and half_width > self.half_width:
+            return False
+        if self.relative is not None and half_width > self.relative * abs(mean):
+            return False
+        return True
+
+    def run(self) -> dict:
+        generator = TrafficGenerator(self.simulation.num_floors, self.arrival_rate, self.pattern, seed=self.seed)
+        state = self.simulation.start(generator, self.max_time)
+
+        horizon = 0.0
+        mean = half_width = float('inf')
+        truncated = 0
+        converged = False
+
+        while horizon < self.max_time:
+            horizon = min(self.max_time, horizon + self.chunk)
+            running = self.simulation.advance(state, horizon)
+
+            waits = state.waits
+            truncated = mser_truncation(waits)
+            retained = waits[truncated:]
+            if len(retained) < 2 * self.num_batches:
+                if not running:
+                    break
+                continue
+
+            mean, half_width = batch_means_interval(retained, self.num_batches)
+            if self._precise_enough(mean, half_width):
+                converged = True
+                break
+            if not running:
+                break
+
+        return {
+            'mean_wait': mean,
+            'half_width': half_width,
+            'converged': converged,
+            'simulated_time': horizon,
+            'warmup_observations': truncated,
+            # Passengers board at a roughly steady rate, so scale the discarded share of the run
+            'warmup_time': truncated * state.now / len(state.waits) if state.waits else 0.0,
+            'observations': len(state.waits) - truncated
+        }
+
+def demonstrate_run_length_control():
+    """Show sequential run lengths adapting to load and precision"""
+    print("=== Warm-Up Detection and Sequential Run Length ===\n")
+    print(f"{'Cars':<6} {'Rate':<6} {'Target':<8} {'Mean wait':<11} {'+/-':<8} {'Warm-up':<9} "
+          f"{'Simulated':<11} {'Converged'}")
+    print("-" * 80)
+
+    for num_cars, rate in ((3, 0.10), (3, 0.18), (2, 0.12)):
+        for relative in (0.10, 0.05):
+            run = SequentialRun(GroupSimulation(num_floors=10, num_cars=num_cars, car_capacity=12),
+                                arrival_rate=rate, pattern='mixed', relative=relative).run()
+            print(f"{num_cars:<6} {rate:<6} {relative:<8.0%} {run['mean_wait']:<11.2f} {run['half_width']:<8.2f} "
+                  f"{run['warmup_observations']:<9} {run['simulated_time'] / 60:<8.0f}min "
+                  f"{'yes' if run['converged'] else 'no'}")
+
+if __name__ == "__main__":
+    demonstrate_run_length_control()
@@ -0,0 +1,76 @@
+import random
+import unittest
+from traffic_simulation import TrafficGenerator, GroupSimulation
+from run_length import mser_truncation, t_critical, batch_means_interval, SequentialRun
+
+class TestWarmUpDetection(unittest.TestCase):
+
+    def test_stationary_series_needs_little_truncation(self):
+        """Test MSER-5 keeps nearly all of a stationary series"""
+        rng = random.Random(1)
+        series = [rng.gauss(10, 1) for _ in range(2000)]
+        self.assertLess(mser_truncation(series), 200)
+
+    def test_initial_transient_is_removed(self):
+        """Test MSER-5 discards a decaying initial bias"""
+        rng = random.Random(2)
+        series = [10 + 40 * 0.99 ** i + rng.gauss(0, 1) for i in range(2000)]
+        truncated = mser_truncation(series)
+        self.assertGreater(truncated, 200)
+        self.assertLessEqual(truncated, 1000)
+
+    def test_short_series_is_not_truncated(self):
+        """Test series shorter than a few batches are left alone"""
+        self.assertEqual(mser_truncation([5.0, 1.0, 1.0]), 0)
+
+class TestConfidenceIntervals(unittest.TestCase):
+
+    def test_t_critical_values(self):
+        """Test the t quantile approximation against tabulated values"""
+        self.assertAlmostEqual(t_critical(19), 2.093, places=2)
+        self.assertAlmostEqual(t_critical(9), 2.262, places=2)
+        self.assertAlmostEqual(t_critical(1000), 1.962, places=2)
+
+    def test_batch_means_covers_mean(self):
+        """Test the batch-means interval covers the true mean of an i.i.d. series"""
+        rng = random.Random(3)
+        mean, half_width = batch_means_interval([rng.expovariate(0.2) for _ in range(4000)])
+        self.assertLess(abs(mean - 5.0), 2 * half_width)
+
+class TestSequentialRun(unittest.TestCase):
+
+    def setUp(self):
+        self.simulation = GroupSimulation(num_floors=8, num_cars=2, car_capacity=10)
+
+    def test_advance_is_resumable(self):
+        """Test advancing in chunks matches a single run over the same horizon"""
+        generator = TrafficGenerator(8, 0.1, 'mixed', seed=5)
+        state = self.simulation.start(generator.copy(), 3600)
+        for until in range(300, 3601, 300):
+            self.simulation.advance(state, until)
+        # Drain passengers still in transit at the horizon, as run() does
+        self.simulation.advance(state, float('inf'))
+        reference = self.simulation.run(generator.copy().generate(3600))
+        self.assertEqual(state.waits, reference['waits'])
+
+    def test_converges_to_requested_precision(self):
+        """Test the run stops once the relative half-width target is met"""
+        result = SequentialRun(self.simulation, arrival_rate=0.08, pattern='mixed', relative=0.1).run()
+        self.assertTrue(result['converged'])
+        self.assertLessEqual(result['half_width'], 0.1 * result['mean_wait'])
+
+    def test_tighter_precision_runs_longer(self):
+        """Test a tighter target never stops earlier than a looser one"""
+        loose = SequentialRun(self.simulation, arrival_rate=0.08, pattern='mixed', relative=0.1).run()
+        tight = SequentialRun(self.simulation, arrival_rate=0.08, pattern='mixed', relative=0.04).run()
+        self.assertGreaterEqual(tight['simulated_time'], loose['simulated_time'])
+
+    def test_max_time_bounds_the_run(self):
+        """Test an unreachable target stops at the time limit unconverged"""
+        result = SequentialRun(self.simulation, arrival_rate=0.08, pattern='mixed',
+                               relative=1e-4, max_time=3600).run()
+        self.assertFalse(result['converged'])
+        self.assertEqual(result['simulated_time'], 3600)
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,438 @@
+from typing import List, Tuple, Optional, Dict
+import heapq
+import math
+import random
+import statistics
+
+class TimingModel:
+    """Car timing model shared by the simulators (all values in seconds)"""
+
+    def __init__(self, seconds_per_floor: float = 1.5, door_cycle: float = 6.0,
+                 seconds_per_passenger: float = 1.0):
+        self.seconds_per_floor = seconds_per_floor
+        self.door_cycle = door_cycle
+        self.seconds_per_passenger = seconds_per_passenger
+
+    def travel_time(self, from_floor: int, to_floor: int) -> float:
+        return abs(to_floor - from_floor) * self.seconds_per_floor
+
+    def transfer_time(self, passengers: int) -> float:
+        """Door cycle plus boarding/alighting time for a group of passengers"""
+        return self.door_cycle + passengers * self.seconds_per_passenger
+
+class TrafficGenerator:
+    """Poisson passenger arrivals for common building traffic patterns.
+
+    Arrival times and trip choices come from separate seeded streams and are
+    drawn by inversion from explicit uniforms, so a given seed yields the
+    same passengers for every policy under comparison (common random
+    numbers), and `antithetic=True` yields the mirrored stream (1 - U).
+    """
+
+    PATTERNS = ('up_peak', 'down_peak', 'interfloor', 'mixed')
+
+    def __init__(self, num_floors: int = 10, arrival_rate: float = 0.1,
+                 pattern: str = 'up_peak', lobby: int = 1, seed: Optional[int] = None,
+                 antithetic: bool = False):
+        if pattern not in self.PATTERNS:
+            raise ValueError(f"Unknown traffic pattern: {pattern}")
+        self.num_floors = num_floors
+        self.arrival_rate = arrival_rate  # Passengers per second
+        self.pattern = pattern
+        self.lobby = lobby
+        self.antithetic = antithetic
+
+        if seed is None:
+            seed = random.getrandbits(64)
+        self.arrival_rng = random.Random(f"{seed}:arrivals")
+        self.trip_rng = random.Random(f"{seed}:trips")
+
+    def _uniform(self, rng: random.Random) -> float:
+        u = rng.random()
+        return 1.0 - u if self.antithetic else u
+
+    @staticmethod
+    def _index(u: float, count: int) -> int:
+        """Index in [0, count) from one uniform"""
+        return min(count - 1, int(u * count))
+
+    def _other_floor(self, floor: int, u: float) -> int:
+        destination = self._index(u, self.num_floors - 1) + 1
+        return destination + 1 if destination >= floor else destination
+
+    def _trip(self) -> Tuple[int, int]:
+        # Always three uniforms (pattern, origin, destination), whichever are
+        # used, so an antithetic partner stays in step arrival by arrival
+        u_pattern, u_origin, u_destination = (self._uniform(self.trip_rng) for _ in range(3))
+        pattern = self.pattern
+        if pattern == 'mixed':
+            pattern = ('up_peak', 'down_peak', 'interfloor')[self._index(u_pattern, 3)]
+
+        if pattern == 'up_peak':
+            return self.lobby, self._other_floor(self.lobby, u_destination)
+        if pattern == 'down_peak':
+            return self._other_floor(self.lobby, u_destination), self.lobby
+        origin = self._index(u_origin, self.num_floors) + 1
+        return origin, self._other_floor(origin, u_destination)
+
+    def _interarrival(self) -> float:
+        u = self._uniform(self.arrival_rng)
+        return -math.log(max(1e-300, 1.0 - u)) / self.arrival_rate
+
+    def copy(self, seed: Optional[int] = None) -> 'TrafficGenerator':
+        """Independent generator continuing this one's streams, or reseeded streams when seed is given"""
+        clone = TrafficGenerator.__new__(TrafficGenerator)
+        clone.__dict__.update(self.__dict__)
+        clone.arrival_rng = random.Random()
+        clone.trip_rng = random.Random()
+        if seed is None:
+            clone.arrival_rng.setstate(self.arrival_rng.getstate())
+            clone.trip_rng.setstate(self.trip_rng.getstate())
+        else:
+            clone.arrival_rng.seed(f"{seed}:arrivals")
+            clone.trip_rng.seed(f"{seed}:trips")
+        return clone
+
+    def generate(self, duration: float) -> List[Tuple[float, int, int]]:
+        """Generate (arrival_time, origin, destination) tuples up to duration seconds"""
+        arrivals = []
+        t = self._interarrival()
+        while t < duration:
+            origin, destination = self._trip()
+            arrivals.append((t, origin, destination))
+            t += self._interarrival()
+        return arrivals
+
+class ArrivalStream:
+    """Arrival source for a running simulation: replays a list or draws lazily from a generator"""
+
+    def __init__(self, arrivals: Optional[List[Tuple[float, int, int]]] = None,
+                 generator: Optional[TrafficGenerator] = None, duration: float = float('inf')):
+        self.arrivals = arrivals
+        self.index = 0
+        self.generator = generator
+        self.duration = duration
+        self.t = 0.0
+        self.upcoming = self._draw()
+
+    def _draw(self) -> Optional[Tuple[float, int, int]]:
+        if self.generator is None:
+            if self.index < len(self.arrivals):
+                self.index += 1
+                return self.arrivals[self.index - 1]
+            return None
+
+        self.t += self.generator._interarrival()
+        if self.t >= self.duration:
+            return None
+        origin, destination = self.generator._trip()
+        return self.t, origin, destination
+
+    def peek_time(self) -> float:
+        return self.upcoming[0] if self.upcoming is not None else float('inf')
+
+    def pop(self) -> Tuple[float, int, int]:
+        arrival = self.upcoming
+        self.upcoming = self._draw()
+        return arrival
+
+    def copy(self, reseed: Optional[int] = None) -> 'ArrivalStream':
+        """Snapshot of the stream; generated streams can be reseeded so clones diverge"""
+        clone = ArrivalStream.__new__(ArrivalStream)
+        clone.__dict__.update(self.__dict__)  # Replayed lists are shared, never mutated
+        if self.generator is not None:
+            clone.generator = self.generator.copy(reseed)
+        return clone
+
+class Car:
+    """State of one car in a group simulation"""
+
+    def __init__(self, car_id: int, floor: int):
+        self.car_id = car_id
+        self.floor = floor
+        self.direction = 0  # -1 down, 0 idle, 1 up
+        self.passengers = []  # (arrival_time, boarding_time, destination)
+        self.busy = False
+        self.hold_since = None  # Time the car began holding at the lobby for more passengers
+
+    def copy(self) -> 'Car':
+        clone = Car(self.car_id, self.floor)
+        clone.direction = self.direction
+        clone.passengers = list(self.passengers)
+        clone.busy = self.busy
+        clone.hold_since = self.hold_since
+        return clone
+
+class GroupState:
+    """Reentrant state of one group simulation run.
+
+    Holds everything needed to resume a run, so a run can be advanced in
+    pieces, snapshotted, and cloned into independent continuations.
+    """
+
+    def __init__(self, num_floors: int, num_cars: int, lobby: int, source: ArrivalStream):
+        self.now = 0.0
+        self.cars = [Car(i, lobby) for i in range(num_cars)]
+        self.waiting = {f: [] for f in range(1, num_floors + 1)}  # (arrival_time, destination)
+        self.claimed = {}  # floor -> car heading there to answer an idle-car dispatch
+        self.holding = {}  # floor -> car loading there with its doors held open
+        self.events = []  # (time, sequence, car_id)
+        self.sequence = 0
+        self.waits = []
+        self.journeys = []
+        self.alighted = None  # Set to a list to record (time, arrival_time, floor) for every alighting passenger
+        self.policy_state = None  # Departure policy's per-run state; immutable, replaced on update
+        self.stops = 0
+        self.source = source
+        self.finished = False
+
+    def snapshot(self, reseed: Optional[int] = None) -> 'GroupState':
+        """Copy of this state; with reseed, future generated arrivals differ from the original"""
+        clone = GroupState.__new__(GroupState)
+        clone.__dict__.update(self.__dict__)
+        clone.cars = [car.copy() for car in self.cars]
+        clone.waiting = {f: list(queue) for f, queue in self.waiting.items()}
+        clone.claimed = dict(self.claimed)
+        clone.holding = dict(self.holding)
+        clone.events = list(self.events)
+        clone.waits = list(self.waits)
+        clone.journeys = list(self.journeys)
+        if self.alighted is not None:
+            clone.alighted = list(self.alighted)
+        clone.source = self.source.copy(reseed)
+        return clone
+
+    def oldest_wait(self, at: Optional[float] = None) -> float:
+        """Age of the longest-waiting passenger still in a hall queue"""
+        at = self.now if at is None else at
+        oldest = min((queue[0][0] for queue in self.waiting.values() if queue), default=None)
+        return at - oldest if oldest is not None else 0.0
+
+    def queue_length(self) -> int:
+        return sum(len(queue) for queue in self.waiting.values())
+
+class GroupSimulation:
+    """Event-driven simulation of a group of cars under collective (SCAN) control.
+
+    An optional departure_policy holds up-bound cars at the lobby to batch
+    passengers: it is told of lobby arrivals (observe_arrival) and asked how
+    much longer a loading car should wait (hold_time). Its per-run state is
+    kept in GroupState.policy_state, so snapshots carry it. While one car
+    holds, other cars leave the lobby queue to it.
+    """
+
+    def __init__(self, num_floors: int = 10, num_cars: int = 2, car_capacity: int = 10,
+                 timing: Optional[TimingModel] = None, lobby: int = 1, departure_policy=None):
+        self.num_floors = num_floors
+        self.num_cars = num_cars
+        self.car_capacity = car_capacity
+        self.timing = timing or TimingModel()
+        self.lobby = lobby
+        self.departure_policy = departure_policy
+
+    def _calls_beyond(self, floor: int, direction: int, waiting: Dict[int, list]) -> bool:
+        if direction > 0:
+            return any(waiting[f] for f in range(floor + 1, self.num_floors + 1))
+        return any(waiting[f] for f in range(1, floor))
+
+    def _nearest_unclaimed(self, car: Car, waiting: Dict[int, list], claimed: Dict[int, int]) -> Optional[int]:
+        best = None
+        for floor, queue in waiting.items():
+            if not queue or claimed.get(floor, car.car_id) != car.car_id:
+                continue
+            if best is None or abs(floor - car.floor) < abs(best - car.floor):
+                best = floor
+        return best
+
+    def start(self, arrivals, duration: Optional[float] = None) -> GroupState:
+        """Create the initial state for a list of arrivals, a TrafficGenerator, or an ArrivalStream"""
+        if isinstance(arrivals, ArrivalStream):
+            source = arrivals
+        elif isinstance(arrivals, TrafficGenerator):
+            source = ArrivalStream(generator=arrivals, duration=duration if duration is not None else float('inf'))
+        else:
+            source = ArrivalStream(arrivals=arrivals)
+        state = GroupState(self.num_floors, self.num_cars, self.lobby, source)
+        if self.departure_policy is not None:
+            state.policy_state = self.departure_policy.initial_state()
+        return state
+
+    def _push(self, state: GroupState, t: float, car_id: int):
+        heapq.heappush(state.events, (t, state.sequence, car_id))
+        state.sequence += 1
+
+    def admit(self, state: GroupState, arrival: tuple):
+        """Queue an (arrival_time, origin, destination) passenger and wake the idle cars"""
+        state.now, origin, destination = arrival
+        state.waiting[origin].append((state.now, destination))
+        if self.departure_policy is not None and origin == self.lobby:
+            state.policy_state = self.departure_policy.observe_arrival(state.policy_state, state.now)
+        self._wake_idle(state)
+
+    def _wake_idle(self, state: GroupState):
+        for car in state.cars:
+            if not car.busy:
+                car.busy = True
+                self._push(state, state.now, car.car_id)
+
+    def step(self, state: GroupState, end_time: float = float('inf')) -> bool:
+        """Process the next arrival or car decision; returns False once the run is over"""
+        if state.finished:
+            return False
+
+        arrival_time = state.source.peek_time()
+        event_time = state.events[0][0] if state.events else float('inf')
+        if arrival_time == float('inf') and event_time == float('inf'):
+            state.finished = True
+            return False
+
+        waiting = state.waiting
+
+        if arrival_time <= event_time:
+            if arrival_time > end_time:
+                state.finished = True
+                return False
+            self.admit(state, state.source.pop())
+            return True
+
+        now, _, car_id = state.events[0]
+        if now > end_time:
+            state.finished = True
+            return False
+        heapq.heappop(state.events)
+        state.now = now
+        car = state.cars[car_id]
+
+        # Unload passengers for this floor
+        staying = [p for p in car.passengers if p[2] != car.floor]
+        alighting = len(car.passengers) - len(staying)
+        for arrived, boarded, destination in car.passengers:
+            if destination == car.floor:
+                state.journeys.append(now - arrived)
+                if state.alighted is not None:
+                    state.alighted.append((now, arrived, destination))
+        car.passengers = staying
+
+        # Pick a direction when the car has none
+        if car.direction == 0:
+            target = self._nearest_unclaimed(car, waiting, state.claimed)
+            if target is not None and target != car.floor:
+                car.direction = 1 if target > car.floor else -1
+                state.claimed[target] = car.car_id
+            elif waiting[car.floor] and state.holding.get(car.floor, car.car_id) == car.car_id:
+                first_destination = waiting[car.floor][0][1]
+                car.direction = 1 if first_destination > car.floor else -1
+
+        # Board passengers travelling in the car's direction
+        boarding = 0
+        remaining = []
+        for arrived, destination in waiting[car.floor]:
+            going = 1 if destination > car.floor else -1
+            if going == car.direction and len(car.passengers) < self.car_capacity:
+                car.passengers.append((arrived, now, destination))
+                state.waits.append(now - arrived)
+                boarding += 1
+            else:
+                remaining.append((arrived, destination))
+        waiting[car.floor] = remaining
+        if state.claimed.get(car.floor) == car.car_id or not remaining:
+            state.claimed.pop(car.floor, None)
+
+        if boarding or alighting:
+            if car.hold_since is None:
+                state.stops += 1
+                self._push(state, now + self.timing.transfer_time(boarding + alighting), car.car_id)
+                if (boarding and self.departure_policy is not None and car.floor == self.lobby and
+                        car.direction == 1 and state.holding.setdefault(car.floor, car.car_id) == car.car_id):
+                    # Claim the lobby from the first boarding, so one car loads at a time
+                    car.hold_since = now
+            else:
+                # Doors are already open: only the boarding time itself
+                self._push(state, now + boarding * self.timing.seconds_per_passenger, car.car_id)
+            return True
+
+        if (self.departure_policy is not None and car.floor == self.lobby and car.direction == 1 and
+                car.passengers and state.holding.get(car.floor) == car.car_id and self._hold(state, car, now)):
+            return True
+
+        # Continue the sweep, reverse, or go idle
+        ahead = car.direction != 0 and (
+            any((d - car.floor) * car.direction > 0 for _, _, d in car.passengers) or
+            self._calls_beyond(car.floor, car.direction, waiting))
+        if not ahead and car.direction != 0 and not car.passengers:
+            car.direction = 0
+            if any(waiting.values()):
+                # Re-dispatch from here on the next decision
+                self._push(state, now, car.car_id)
+            else:
+                car.busy = False
+            return True
+        if car.direction == 0:
+            car.busy = False
+            return True
+
+        car.floor += car.direction
+        self._push(state, now + self.timing.seconds_per_floor, car.car_id)
+        return True
+
+    def _hold(self, state: GroupState, car: Car, now: float) -> bool:
+        """Keep a loaded up-bound car at the lobby while the policy asks; returns True while holding"""
+        remaining = 0.0
+        if len(car.passengers) < self.car_capacity:
+            remaining = self.departure_policy.hold_time(self, car, now - car.hold_since, state.policy_state)
+        if remaining > 1e-9:
+            # Re-check once per boarding time so arrivals board as they come
+            self._push(state, now + min(remaining, self.timing.seconds_per_passenger), car.car_id)
+            return True
+
+        car.hold_since = None
+        state.holding.pop(car.floor, None)
+        if state.waiting[car.floor]:
+            # Hand any remaining queue to the next car
+            self._wake_idle(state)
+        return False
+
+    def advance(self, state: GroupState, until: float) -> bool:
+        """Process every event up to `until`, leaving the run resumable; returns False once it is over"""
+        while not state.finished:
+            event_time = state.events[0][0] if state.events else float('inf')
+            if min(state.source.peek_time(), event_time) > until:
+                return True
+            self.step(state)
+        return False
+
+    def run(self, arrivals, duration: Optional[float] = None) -> dict:
+        """Simulate the given arrivals and return passenger wait statistics"""
+        state = self.start(arrivals, duration)
+        end_time = duration if duration is not None else float('inf')
+        while self.step(state, end_time):
+            pass
+        return self.summarise(state)
+
+    def summarise(self, state: GroupState) -> dict:
+        ordered = sorted(state.waits)
+        return {
+            'passengers_served': len(ordered),
+            'mean_wait': statistics.mean(ordered) if ordered else 0.0,
+            'p95_wait': ordered[min(len(ordered) - 1, int(0.95 * len(ordered)))] if ordered else 0.0,
+            'max_wait': ordered[-1] if ordered else 0.0,
+            'mean_journey': statistics.mean(state.journeys) if state.journeys else 0.0,
+            'stops': state.stops,
+            'end_time': state.now,
+            'waits': state.waits
+        }
+
+def demonstrate_traffic_simulation():
+    """Demonstrate group simulation under up-peak traffic"""
+    print("=== Group Traffic Simulation Demonstration ===\n")
+
+    arrivals = TrafficGenerator(num_floors=10, arrival_rate=0.15, pattern='up_peak', seed=7).generate(3600)
+    print(f"Generated {len(arrivals)} up-peak arrivals over one hour")
+
+    for num_cars in (1, 2, 3, 4):
+        result = GroupSimulation(num_floors=10, num_cars=num_cars, car_capacity=12).run(arrivals)
+        print(f"  {num_cars} car(s): mean wait {result['mean_wait']:.1f}s, "
+              f"p95 wait {result['p95_wait']:.1f}s, served {result['passengers_served']}")
+
+if __name__ == "__main__":
+    demonstrate_traffic_simulation()
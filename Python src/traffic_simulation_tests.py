@@ -0,0 +1,79 @@
+import unittest
+from traffic_simulation import TimingModel, TrafficGenerator, GroupSimulation
+
+class TestTrafficGenerator(unittest.TestCase):
+
+    def test_up_peak_from_lobby(self):
+        """Test up-peak passengers all start at the lobby and go elsewhere"""
+        arrivals = TrafficGenerator(num_floors=10, arrival_rate=0.5, pattern='up_peak', seed=1).generate(600)
+        self.assertGreater(len(arrivals), 0)
+        for _, origin, destination in arrivals:
+            self.assertEqual(origin, 1)
+            self.assertTrue(2 <= destination <= 10)
+
+    def test_down_peak_to_lobby(self):
+        """Test down-peak passengers all travel to the lobby"""
+        arrivals = TrafficGenerator(num_floors=10, arrival_rate=0.5, pattern='down_peak', seed=1).generate(600)
+        for _, origin, destination in arrivals:
+            self.assertEqual(destination, 1)
+            self.assertNotEqual(origin, 1)
+
+    def test_interfloor_never_same_floor(self):
+        """Test interfloor trips always change floor"""
+        arrivals = TrafficGenerator(num_floors=5, arrival_rate=1.0, pattern='interfloor', seed=3).generate(300)
+        for _, origin, destination in arrivals:
+            self.assertNotEqual(origin, destination)
+            self.assertTrue(1 <= destination <= 5)
+
+    def test_arrival_rate(self):
+        """Test the Poisson rate is close to the requested rate"""
+        arrivals = TrafficGenerator(arrival_rate=0.2, seed=5).generate(20000)
+        self.assertAlmostEqual(len(arrivals) / 20000, 0.2, delta=0.02)
+
+    def test_same_seed_same_stream(self):
+        """Test generated streams are reproducible"""
+        first = TrafficGenerator(pattern='mixed', seed=9).generate(1000)
+        second = TrafficGenerator(pattern='mixed', seed=9).generate(1000)
+        self.assertEqual(first, second)
+
+    def test_unknown_pattern(self):
+        """Test unknown traffic patterns are rejected"""
+        with self.assertRaises(ValueError):
+            TrafficGenerator(pattern='lunch')
+
+class TestGroupSimulation(unittest.TestCase):
+
+    def setUp(self):
+        self.timing = TimingModel(seconds_per_floor=1.0, door_cycle=2.0, seconds_per_passenger=0.5)
+
+    def test_single_passenger_journey(self):
+        """Test wait and journey time for one passenger"""
+        simulation = GroupSimulation(num_floors=5, num_cars=1, car_capacity=4, timing=self.timing)
+        result = simulation.run([(0.0, 3, 5)])
+        # Car travels lobby -> 3 (2s), boards, dwell 2.5s, travels 3 -> 5 (2s)
+        self.assertEqual(result['passengers_served'], 1)
+        self.assertAlmostEqual(result['mean_wait'], 2.0)
+        self.assertAlmostEqual(result['mean_journey'], 6.5)
+
+    def test_everyone_served(self):
+        """Test all passengers are eventually served under mixed traffic"""
+        arrivals = TrafficGenerator(num_floors=8, arrival_rate=0.2, pattern='mixed', seed=2).generate(1800)
+        result = GroupSimulation(num_floors=8, num_cars=3, car_capacity=8).run(arrivals)
+        self.assertEqual(result['passengers_served'], len(arrivals))
+
+    def test_more_cars_shorter_waits(self):
+        """Test adding cars reduces the mean wait"""
+        arrivals = TrafficGenerator(num_floors=10, arrival_rate=0.15, seed=4).generate(3600)
+        two = GroupSimulation(num_cars=2, car_capacity=12).run(arrivals)
+        four = GroupSimulation(num_cars=4, car_capacity=12).run(arrivals)
+        self.assertLess(four['mean_wait'], two['mean_wait'])
+
+    def test_duration_cutoff(self):
+        """Test the simulation stops at the requested duration"""
+        arrivals = TrafficGenerator(arrival_rate=0.2, seed=6).generate(3600)
+        result = GroupSimulation(num_cars=2).run(arrivals, duration=600)
+        self.assertLessEqual(result['end_time'], 600 + 60)
+        self.assertLess(result['passengers_served'], len(arrivals))
+
+if __name__ == "__main__":
+    unittest.main()